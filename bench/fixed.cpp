@@ -0,0 +1,82 @@
+// Compares the Q15 and Q31 conversions with the float ones over a batch of
+// values, as when mapping a list of parameters for display. Prints the
+// fastest of several runs in nanoseconds per value.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <tweak/convert.hpp>
+#include <tweak/fastmath.hpp>
+#include <tweak/fixed.hpp>
+
+namespace {
+
+constexpr auto COUNT   = size_t(4096);
+constexpr auto REPEATS = 200;
+constexpr auto RUNS    = 5;
+
+// Keeps the results alive without compiler specific barriers
+void* volatile escape = nullptr;
+
+template <class T, class Fn>
+auto measure(const char* name, const std::vector<T>& in, Fn fn) -> void {
+	auto out  = std::vector<T>(in.size());
+	auto best = 1e30;
+	for (auto run = 0; run < RUNS; run++) {
+		const auto start = std::chrono::steady_clock::now();
+		for (auto r = 0; r < REPEATS; r++) {
+			for (size_t i = 0; i < in.size(); i++) { out[i] = fn(in[i]); }
+			escape = out.data();
+		}
+		const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		best = std::min(best, elapsed / double(REPEATS * in.size()));
+	}
+	std::printf("  %-28s %6.2f ns\n", name, best);
+}
+
+template <class Q>
+auto fixed_values(const std::vector<float>& in, float scale) -> std::vector<Q> {
+	auto out = std::vector<Q>(in.size());
+	std::transform(in.begin(), in.end(), out.begin(), [scale](float v) { return tweak::fixed::to_fixed<Q>(v / scale); });
+	return out;
+}
+
+} // namespace
+
+auto main() -> int {
+	namespace convert  = tweak::convert;
+	namespace fastmath = tweak::fastmath;
+	namespace fixed    = tweak::fixed;
+	auto db    = std::vector<float>(COUNT);
+	auto pitch = std::vector<float>(COUNT);
+	auto unit  = std::vector<float>(COUNT);
+	for (size_t i = 0; i < COUNT; i++) {
+		const auto x = float(i) / float(COUNT);
+		db[i]    = -60.0f + 72.0f * x;
+		pitch[i] = 127.0f * x;
+		unit[i]  = x;
+	}
+	std::printf("db_to_linear\n");
+	measure("float const_math", db, [](float v) { return convert::db_to_linear(v); });
+	measure("float fastmath::coarse", db, [](float v) { return convert::db_to_linear(v, fastmath::coarse); });
+	measure("float fastmath::full", db, [](float v) { return convert::db_to_linear(v, fastmath::full); });
+	measure("q15", fixed_values<fixed::q15>(db, fixed::DB_SCALE), [](fixed::q15 v) { return fixed::db_to_linear(v); });
+	measure("q31", fixed_values<fixed::q31>(db, fixed::DB_SCALE), [](fixed::q31 v) { return fixed::db_to_linear(v); });
+	std::printf("pitch_to_frequency\n");
+	measure("float const_math", pitch, [](float v) { return convert::pitch_to_frequency(v); });
+	measure("float fastmath::coarse", pitch, [](float v) { return convert::pitch_to_frequency(v, fastmath::coarse); });
+	measure("float fastmath::full", pitch, [](float v) { return convert::pitch_to_frequency(v, fastmath::full); });
+	measure("q15", fixed_values<fixed::q15>(pitch, fixed::PITCH_SCALE), [](fixed::q15 v) { return fixed::pitch_to_frequency(v); });
+	measure("q31", fixed_values<fixed::q31>(pitch, fixed::PITCH_SCALE), [](fixed::q31 v) { return fixed::pitch_to_frequency(v); });
+	std::printf("lerp\n");
+	measure("float", unit, [](float v) { return tweak::math::lerp(-0.25f, 0.75f, v); });
+	measure("q15", fixed_values<fixed::q15>(unit, 1.0f), [](fixed::q15 v) { return fixed::lerp(fixed::q15(-8192), fixed::q15(24576), v); });
+	measure("q31", fixed_values<fixed::q31>(unit, 1.0f), [](fixed::q31 v) { return fixed::lerp(fixed::q31(-536870912), fixed::q31(1610612736), v); });
+	std::printf("stepify\n");
+	measure("float", unit, [](float v) { return tweak::math::stepify(v, 0.01f); });
+	measure("q15", fixed_values<fixed::q15>(unit, 1.0f), [](fixed::q15 v) { return fixed::stepify(v, fixed::q15(328)); });
+	measure("q31", fixed_values<fixed::q31>(unit, 1.0f), [](fixed::q31 v) { return fixed::stepify(v, fixed::q31(21474836)); });
+	return 0;
+}
@@ -0,0 +1,54 @@
+# Measures how long the compiler takes to parse each public header on its
+# own. Run through the tweak-header-cost target, or directly with:
+#   cmake -DTWEAK_CXX_COMPILER=<compiler> -DTWEAK_CXX_COMPILER_ID=<id> -DTWEAK_INCLUDE_DIR=<dir> -P header-cost.cmake
+
+if (NOT DEFINED TWEAK_REPEATS)
+	set(TWEAK_REPEATS 3)
+endif()
+set(work_dir "${CMAKE_CURRENT_BINARY_DIR}/tweak-header-cost")
+file(MAKE_DIRECTORY "${work_dir}")
+file(GLOB_RECURSE headers RELATIVE "${TWEAK_INCLUDE_DIR}" "${TWEAK_INCLUDE_DIR}/tweak/*.hpp")
+list(SORT headers)
+
+if (TWEAK_CXX_COMPILER_ID STREQUAL "MSVC")
+	set(flags /nologo /std:c++20 /Zs /EHsc /TP /D_USE_MATH_DEFINES "/I${TWEAK_INCLUDE_DIR}")
+else()
+	set(flags -std=c++20 -fsyntax-only -D_USE_MATH_DEFINES "-I${TWEAK_INCLUDE_DIR}")
+endif()
+
+function(now_us out)
+	string(TIMESTAMP s "%s" UTC)
+	string(TIMESTAMP us "%f" UTC)
+	math(EXPR t "${s} * 1000000 + ${us}")
+	set(${out} ${t} PARENT_SCOPE)
+endfunction()
+
+# Fastest of TWEAK_REPEATS compiles, in milliseconds
+function(measure source out)
+	set(best -1)
+	foreach (i RANGE 1 ${TWEAK_REPEATS})
+		now_us(start)
+		execute_process(COMMAND "${TWEAK_CXX_COMPILER}" ${flags} "${source}" RESULT_VARIABLE result OUTPUT_QUIET ERROR_VARIABLE error)
+		now_us(end)
+		if (NOT result EQUAL 0)
+			message(FATAL_ERROR "Failed to compile ${source}:\n${error}")
+		endif()
+		math(EXPR elapsed "(${end} - ${start}) / 1000")
+		if (best LESS 0 OR elapsed LESS best)
+			set(best ${elapsed})
+		endif()
+	endforeach()
+	set(${out} ${best} PARENT_SCOPE)
+endfunction()
+
+file(WRITE "${work_dir}/empty.cpp" "")
+measure("${work_dir}/empty.cpp" baseline)
+message("baseline (empty TU): ${baseline} ms")
+foreach (header ${headers})
+	string(MAKE_C_IDENTIFIER "${header}" name)
+	set(source "${work_dir}/${name}.cpp")
+	file(WRITE "${source}" "#include <${header}>\n")
+	measure("${source}" total)
+	math(EXPR cost "${total} - ${baseline}")
+	message("${header}: ${cost} ms")
+endforeach()
@@ -0,0 +1,257 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "format.hpp"
+#include "policy.hpp"
+#include "std/policies.hpp"
+
+namespace tweak {
+
+// Which policy an any_param follows. Kinds from user up are registered
+// at runtime with register_policy.
+enum class param_kind : std::uint8_t {
+	amp,
+	frequency,
+	ms,
+	percentage,
+	bipolar_percentage,
+	pitch,
+	ratio,
+	speed,
+	user,
+};
+
+inline constexpr auto BUILTIN_KINDS  = size_t(param_kind::user);
+inline constexpr auto MAX_USER_KINDS = size_t(32);
+
+// Function table for a user policy. The members are named like a policy's
+// so generic code can call either the same way.
+struct user_policy {
+	float MIN;
+	float MAX;
+	float DEFAULT;
+	auto (*constrain)(float) -> float;
+	auto (*stepify)(float) -> float;
+	auto (*increment)(float, bool) -> float;
+	auto (*decrement)(float, bool) -> float;
+	auto (*drag)(float, int, bool) -> float;
+	auto (*to_normalized)(float) -> float;
+	auto (*from_normalized)(float) -> float;
+	auto (*to_label)(float) -> label;
+	auto (*from_string)(std::string_view) -> std::optional<float>;
+};
+
+template <formattable_policy P> requires std::same_as<typename P::value_type, float> [[nodiscard]] constexpr
+auto make_user_policy() -> user_policy {
+	return {
+		P::MIN, P::MAX, P::DEFAULT,
+		&P::constrain, &P::stepify, &P::increment, &P::decrement, &P::drag,
+		&P::to_normalized, &P::from_normalized, &P::to_label, &P::from_string,
+	};
+}
+
+namespace detail {
+
+inline auto user_policies     = std::array<user_policy, MAX_USER_KINDS>{};
+inline auto user_policy_count = size_t(0);
+
+} // detail
+
+// Registers P and returns the kind to create its handles with, or nullopt
+// once MAX_USER_KINDS are taken. Registering the same P again returns the
+// same kind. Not thread safe, so register everything up front.
+template <formattable_policy P> requires std::same_as<typename P::value_type, float>
+auto register_policy() -> std::optional<param_kind> {
+	static const auto k = []() -> std::optional<param_kind> {
+		if (detail::user_policy_count >= MAX_USER_KINDS) { return std::nullopt; }
+		detail::user_policies[detail::user_policy_count] = make_user_policy<P>();
+		return param_kind(BUILTIN_KINDS + detail::user_policy_count++);
+	}();
+	return k;
+}
+
+// Calls fn with the policy for k. Built in kinds pass an empty policy
+// object, so fn is instantiated once per policy and the switch compiles to
+// a jump table. User kinds pass their user_policy. Kinds which were never
+// registered are a bug, and get the percentage policy in release builds.
+template <class Fn>
+auto visit(param_kind k, Fn&& fn) -> decltype(auto) {
+	namespace policies = std_::policies;
+	const auto user = size_t(k) - BUILTIN_KINDS;
+	switch (k) {
+		case param_kind::amp:                { return fn(policies::amp<>{}); }
+		case param_kind::frequency:          { return fn(policies::frequency<>{}); }
+		case param_kind::ms:                 { return fn(policies::ms<>{}); }
+		case param_kind::percentage:         { return fn(policies::percentage<>{}); }
+		case param_kind::bipolar_percentage: { return fn(policies::bipolar_percentage<>{}); }
+		case param_kind::pitch:              { return fn(policies::pitch<>{}); }
+		case param_kind::ratio:              { return fn(policies::ratio<>{}); }
+		case param_kind::speed:              { return fn(policies::speed<>{}); }
+		default: {
+			assert(user < detail::user_policy_count);
+			if (user >= detail::user_policy_count) { return fn(policies::percentage<>{}); }
+			return fn(std::as_const(detail::user_policies[user]));
+		}
+	}
+}
+
+// A parameter of any policy in 16 bytes: its kind, the range it is limited
+// to within the policy's range, and its value.
+struct any_param {
+	any_param() : any_param{param_kind::percentage} {}
+	any_param(param_kind k) : kind_{k} {
+		visit(k, [this](const auto& p) {
+			min_   = p.MIN;
+			max_   = p.MAX;
+			value_ = p.DEFAULT;
+		});
+	}
+	// min and max are swapped if they are the wrong way round
+	any_param(param_kind k, float min, float max, float value) : kind_{k}, min_{std::min(min, max)}, max_{std::max(min, max)} { set(value); }
+	[[nodiscard]] auto kind() const -> param_kind { return kind_; }
+	[[nodiscard]] auto min() const -> float { return min_; }
+	[[nodiscard]] auto max() const -> float { return max_; }
+	[[nodiscard]] auto value() const -> float { return value_; }
+	[[nodiscard]] auto constrain(float v) const -> float { return visit(kind_, [this, v](const auto& p) { return apply_constrain(p, v); }); }
+	[[nodiscard]] auto normalized() const -> float { return visit(kind_, [this](const auto& p) { return p.to_normalized(value_); }); }
+	[[nodiscard]] auto to_label() const -> label { return visit(kind_, [this](const auto& p) { return p.to_label(value_); }); }
+	auto set(float v) -> void { value_ = constrain(v); }
+	auto set_normalized(float v) -> void { visit(kind_, [this, v](const auto& p) { apply_set_normalized(p, v); }); }
+	auto stepify() -> void { visit(kind_, [this](const auto& p) { apply_stepify(p); }); }
+	auto increment(bool precise) -> void { visit(kind_, [this, precise](const auto& p) { apply_increment(p, precise); }); }
+	auto decrement(bool precise) -> void { visit(kind_, [this, precise](const auto& p) { apply_decrement(p, precise); }); }
+	auto drag(int amount, bool precise) -> void { visit(kind_, [this, amount, precise](const auto& p) { apply_drag(p, amount, precise); }); }
+	// Returns false, leaving the value alone, if the string doesn't parse
+	auto from_string(std::string_view str) -> bool {
+		const auto v = visit(kind_, [str](const auto& p) { return p.from_string(str); });
+		if (!v) { return false; }
+		set(*v);
+		return true;
+	}
+	// The operations with the policy already resolved, for the batch loops
+	template <class P> [[nodiscard]] auto apply_constrain(const P& p, float v) const -> float { return std::clamp(p.constrain(v), min_, max_); }
+	template <class P> auto apply_set_normalized(const P& p, float v) -> void { value_ = apply_constrain(p, p.from_normalized(v)); }
+	template <class P> auto apply_stepify(const P& p) -> void { value_ = apply_constrain(p, p.stepify(value_)); }
+	template <class P> auto apply_increment(const P& p, bool precise) -> void { value_ = apply_constrain(p, p.increment(value_, precise)); }
+	template <class P> auto apply_decrement(const P& p, bool precise) -> void { value_ = apply_constrain(p, p.decrement(value_, precise)); }
+	template <class P> auto apply_drag(const P& p, int amount, bool precise) -> void { value_ = apply_constrain(p, p.drag(value_, amount, precise)); }
+private:
+	param_kind kind_;
+	float min_;
+	float max_;
+	float value_;
+};
+
+static_assert(sizeof(any_param) == 16);
+
+[[nodiscard]] inline auto kind_of(const any_param& param) -> param_kind { return param.kind(); }
+[[nodiscard]] inline auto kind_of(param_kind k) -> param_kind { return k; }
+
+// Indices of a list of handles (or of just their kinds) bucketed by kind,
+// with all user kinds in one bucket. Rebuild it whenever the list or the
+// kinds in it change.
+struct kind_index {
+	kind_index() = default;
+	kind_index(std::span<const any_param> params) { build(params); }
+	kind_index(std::span<const param_kind> kinds) { build(kinds); }
+	auto build(std::span<const any_param> params) -> void { build_from(params); }
+	auto build(std::span<const param_kind> kinds) -> void { build_from(kinds); }
+	[[nodiscard]] auto group(param_kind k) const -> std::span<const std::uint32_t> {
+		const auto b = bucket(k);
+		return std::span{indices_}.subspan(offsets_[b], offsets_[b + 1] - offsets_[b]);
+	}
+	[[nodiscard]] auto size() const -> size_t { return indices_.size(); }
+private:
+	template <class T>
+	auto build_from(std::span<const T> params) -> void {
+		auto counts = std::array<std::uint32_t, BUILTIN_KINDS + 1>{};
+		for (const auto& param : params) {
+			counts[bucket(kind_of(param))]++;
+		}
+		offsets_[0] = 0;
+		for (size_t i = 0; i < counts.size(); i++) {
+			offsets_[i + 1] = offsets_[i] + counts[i];
+		}
+		auto pos = offsets_;
+		indices_.resize(params.size());
+		for (size_t i = 0; i < params.size(); i++) {
+			indices_[pos[bucket(kind_of(params[i]))]++] = static_cast<std::uint32_t>(i);
+		}
+	}
+	[[nodiscard]] static auto bucket(param_kind k) -> size_t { return std::min(size_t(k), BUILTIN_KINDS); }
+	std::array<std::uint32_t, BUILTIN_KINDS + 2> offsets_ = {};
+	std::vector<std::uint32_t> indices_;
+};
+
+} // tweak
+
+namespace tweak::batch {
+
+// Runs fn(policy, i) for every handle, one loop per built in policy.
+// User kinds still dispatch per handle.
+template <class Fn>
+auto for_each_grouped(const kind_index& index, Fn&& fn) -> void {
+	for (size_t k = 0; k < BUILTIN_KINDS; k++) {
+		const auto group = index.group(param_kind(k));
+		if (group.empty()) { continue; }
+		visit(param_kind(k), [&](const auto& p) {
+			for (const auto i : group) {
+				fn(p, i);
+			}
+		});
+	}
+}
+
+// Params is a span of handles or of kinds
+template <class Params, class Fn>
+auto for_each_user(Params params, const kind_index& index, Fn&& fn) -> void {
+	for (const auto i : index.group(param_kind::user)) {
+		visit(kind_of(params[i]), [&](const auto& p) { fn(p, i); });
+	}
+}
+
+template <class Params, class Fn>
+auto for_each(Params params, const kind_index& index, Fn&& fn) -> void {
+	for_each_grouped(index, fn);
+	for_each_user(params, index, fn);
+}
+
+inline auto stepify(std::span<any_param> params, const kind_index& index) -> void {
+	for_each(params, index, [params](const auto& p, size_t i) { params[i].apply_stepify(p); });
+}
+
+inline auto increment(std::span<any_param> params, const kind_index& index, bool precise) -> void {
+	for_each(params, index, [params, precise](const auto& p, size_t i) { params[i].apply_increment(p, precise); });
+}
+
+inline auto decrement(std::span<any_param> params, const kind_index& index, bool precise) -> void {
+	for_each(params, index, [params, precise](const auto& p, size_t i) { params[i].apply_decrement(p, precise); });
+}
+
+inline auto drag(std::span<any_param> params, const kind_index& index, int amount, bool precise) -> void {
+	for_each(params, index, [params, amount, precise](const auto& p, size_t i) { params[i].apply_drag(p, amount, precise); });
+}
+
+// The index must have been built from params, and out must be at least as
+// long as params.
+inline auto to_normalized(std::span<const any_param> params, const kind_index& index, std::span<float> out) -> void {
+	for_each(params, index, [params, out](const auto& p, size_t i) { out[i] = p.to_normalized(params[i].value()); });
+}
+
+inline auto from_normalized(std::span<any_param> params, const kind_index& index, std::span<const float> in) -> void {
+	for_each(params, index, [params, in](const auto& p, size_t i) { params[i].apply_set_normalized(p, in[i]); });
+}
+
+inline auto to_label(std::span<const any_param> params, const kind_index& index, std::span<label> out) -> void {
+	for_each(params, index, [params, out](const auto& p, size_t i) { out[i] = p.to_label(params[i].value()); });
+}
+
+} // tweak::batch
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cmath>
+#include <span>
+#include <vector>
+#include "convert.hpp"
+#include "format.hpp"
+#include "std/amp.hpp"
+#include "std/frequency.hpp"
+#include "std/ms.hpp"
+#include "std/speed.hpp"
+
+namespace tweak::axis {
+
+// Minimum distance in pixels between two labelled ticks
+inline constexpr auto LABEL_SPACING = 48.0f;
+// Minimum distance in pixels between two unlabelled ticks
+inline constexpr auto MINOR_SPACING = 8.0f;
+
+template <std::floating_point T>
+struct tick {
+	T position; // In pixels, from 0 to the axis width
+	label text; // Empty for minor ticks
+	bool major;
+};
+
+template <std::floating_point T>
+struct range {
+	T min;
+	T max;
+	int width;
+	[[nodiscard]] auto operator==(const range&) const -> bool = default;
+};
+
+// Smallest of 1, 2, 5 * 10^n such that consecutive steps across the range
+// are at least min_spacing pixels apart.
+template <std::floating_point T> [[nodiscard]]
+auto nice_step(T span, int width, T min_spacing) -> T {
+	if (span <= T(0) || width <= 0) { return T(0); }
+	const auto raw  = span * min_spacing / T(width);
+	const auto base = std::pow(T(10), std::floor(std::log10(raw)));
+	for (const auto m : {T(1), T(2), T(5), T(10)}) {
+		if (base * m >= raw) { return base * m; }
+	}
+	return base * T(10);
+}
+
+namespace detail {
+
+template <std::floating_point T, class LabelFn>
+auto linear(range<T> r, std::vector<tick<T>>* out, LabelFn&& to_label) -> void {
+	const auto step = nice_step(r.max - r.min, r.width, T(LABEL_SPACING));
+	if (step <= T(0)) { return; }
+	const auto scale     = T(r.width) / (r.max - r.min);
+	const auto divisions =
+		step / T(5) * scale >= T(MINOR_SPACING) ? 5 :
+		step / T(2) * scale >= T(MINOR_SPACING) ? 2 : 1;
+	const auto minor_step = step / T(divisions);
+	const auto first      = static_cast<long long>(std::ceil(r.min / minor_step));
+	const auto last       = static_cast<long long>(std::floor(r.max / minor_step));
+	for (auto i = first; i <= last; i++) {
+		const auto value = T(i) * minor_step;
+		const auto major = i % divisions == 0;
+		out->push_back({(value - r.min) * scale, major ? to_label(value) : label{}, major});
+	}
+}
+
+} // detail
+
+// Meters and faders. The range is in decibels and positions are linear in dB.
+struct db {
+	template <std::floating_point T>
+	static auto generate(range<T> r, std::vector<tick<T>>* out) -> void {
+		detail::linear(r, out, [](T v) { return std_::amp::db_to_label(math::stepify(v, T(0.1))); });
+	}
+};
+
+// Timeline rulers. The range is in milliseconds.
+struct ms {
+	template <std::floating_point T>
+	static auto generate(range<T> r, std::vector<tick<T>>* out) -> void {
+		detail::linear(r, out, [](T v) { return std_::ms::to_label(v); });
+	}
+};
+
+// EQ and spectrum displays. The range is in Hz and positions follow
+// convert::filter_hz_to_linear. Ticks are placed at 1..9 * 10^n with
+// labels on 1, 2 and 5 where they fit.
+struct frequency {
+	template <std::floating_point T>
+	static auto generate(range<T> r, std::vector<tick<T>>* out) -> void {
+		if (r.min <= T(0) || r.max <= r.min || r.width <= 0) { return; }
+		const auto lo          = convert::filter_hz_to_linear(r.min);
+		const auto hi          = convert::filter_hz_to_linear(r.max);
+		const auto to_position = [=](T hz) { return math::inverse_lerp(lo, hi, convert::filter_hz_to_linear(hz)) * T(r.width); };
+		auto last_label = -T(LABEL_SPACING);
+		auto last_minor = -T(MINOR_SPACING);
+		for (auto e = static_cast<int>(std::floor(std::log10(r.min))); e <= static_cast<int>(std::ceil(std::log10(r.max))); e++) {
+			const auto decade = std::pow(T(10), T(e));
+			for (auto m = 1; m < 10; m++) {
+				const auto hz = decade * T(m);
+				if (hz < r.min || hz > r.max) { continue; }
+				const auto position = to_position(hz);
+				const auto major    = m == 1;
+				const auto labelled = (m == 1 || m == 2 || m == 5) && position - last_label >= T(LABEL_SPACING);
+				if (labelled) {
+					out->push_back({position, std_::frequency::to_label(hz), major});
+					last_label = position;
+					last_minor = position;
+				}
+				else if (position - last_minor >= T(MINOR_SPACING)) {
+					out->push_back({position, label{}, major});
+					last_minor = position;
+				}
+			}
+		}
+	}
+};
+
+// Speed rulers. The range is a playback speed and positions are linear in
+// octaves. Ticks are placed on powers of two.
+struct speed {
+	template <std::floating_point T>
+	static auto generate(range<T> r, std::vector<tick<T>>* out) -> void {
+		if (r.min <= T(0) || r.max <= r.min || r.width <= 0) { return; }
+		const auto lo     = std::log2(r.min);
+		const auto hi     = std::log2(r.max);
+		const auto scale  = T(r.width) / (hi - lo);
+		auto stride = 1;
+		while (T(stride) * scale < T(LABEL_SPACING) && stride < 64) { stride *= 2; }
+		for (auto octave = static_cast<int>(std::ceil(lo)); octave <= static_cast<int>(std::floor(hi)); octave++) {
+			const auto labelled = octave % stride == 0;
+			if (!labelled && scale < T(MINOR_SPACING)) { continue; }
+			const auto value = std::exp2(T(octave));
+			out->push_back({(T(octave) - lo) * scale, labelled ? std_::speed::to_label(value) : label{}, labelled});
+		}
+	}
+};
+
+// Holds the ticks for one axis. They are only regenerated when the range or
+// width changes so repaints don't pay for any formatting.
+template <class Axis, std::floating_point T = float>
+struct cache {
+	[[nodiscard]] auto get(T min, T max, int width) -> std::span<const tick<T>> {
+		const auto r = range<T>{min, max, width};
+		if (!valid_ || r != range_) {
+			ticks_.clear();
+			Axis::generate(r, &ticks_);
+			range_ = r;
+			valid_ = true;
+		}
+		return ticks_;
+	}
+	auto invalidate() -> void {
+		valid_ = false;
+	}
+private:
+	range<T> range_ = {};
+	std::vector<tick<T>> ticks_;
+	bool valid_ = false;
+};
+
+} // tweak::axis
@@ -37,7 +37,7 @@ auto cube(T x) -> T {
 
 template <typename T> [[nodiscard]] constexpr
 auto sqrt_helper(T x, T g) -> T {
-	return abs(g - x / g) < EPSILON<T> ? g : sqrt_helper(x, (g + x / g) / 2);
+	return abs(g - x / g) < EPSILON<T> ? (g + x / g) / 2 : sqrt_helper(x, (g + x / g) / 2);
 }
 
 template <typename T> [[nodiscard]] constexpr
@@ -146,6 +146,11 @@ auto exp(T x) -> T {
 	return pow(M_E, static_cast<int>(nearest(x))) * exp_helper(fraction(x));
 }
 
+template <typename T> [[nodiscard]] constexpr
+auto exp2(T x) -> T {
+	return exp(x * T(0.69314718055994530942));
+}
+
 template <typename T> [[nodiscard]] constexpr
 auto mantissa(T x) -> T {
 	return x >= 10 ? mantissa(x / 10) : x < 1 ? mantissa(x * 10) : x;
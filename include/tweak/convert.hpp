@@ -1,6 +1,9 @@
 #pragma once
 
+#include <cmath>
+#include <limits>
 #include "const-math.hpp"
+#include "fastmath.hpp"
 #include "math.hpp"
 
 namespace tweak::convert {
@@ -8,7 +11,7 @@ namespace tweak::convert {
 template <class T> [[nodiscard]] constexpr
 auto linear_to_ratio(T v, T max = T(100)) -> T {
 	if (v <= 0) { return 1.0f; }
-	else        { return const_math::pow(max, const_math::pow(v, T(2))); }
+	else        { return const_math::exp(v * v * const_math::log(max)); }
 }
 
 template <class T> [[nodiscard]] constexpr
@@ -29,7 +32,7 @@ auto uni_to_bi(T v) {
 
 template <class T> [[nodiscard]] constexpr
 auto pitch_to_frequency(T v) -> T {
-	return T(8.1758) * const_math::pow(T(2), v / T(12));
+	return T(8.1758) * const_math::exp2(v / T(12));
 }
 
 template <class T> [[nodiscard]] constexpr
@@ -39,12 +42,12 @@ auto frequency_to_pitch(T v) -> T {
 
 template <class T> [[nodiscard]] constexpr
 auto linear_to_filter_hz(T v) -> T {
-	return pitch_to_frequency(lerp(T(-8.513f), T(135.076f), v));
+	return pitch_to_frequency(math::lerp(T(-8.513f), T(135.076f), v));
 }
 
 template <class T> [[nodiscard]] constexpr
 auto filter_hz_to_linear(T v) -> T {
-	return inverse_lerp(T(-8.513f), T(135.076f), frequency_to_pitch(v));
+	return math::inverse_lerp(T(-8.513f), T(135.076f), frequency_to_pitch(v));
 }
 
 template <class T> [[nodiscard]] constexpr
@@ -59,7 +62,8 @@ auto db_to_linear(T v) -> T {
 
 template <class T> [[nodiscard]] constexpr
 auto linear_to_speed(T v) -> T {
-	return const_math::pow(T(0.5), -v);
+	const auto octaves = const_math::floor(v);
+	return const_math::pow(T(2), static_cast<int>(octaves)) * const_math::exp2(v - octaves);
 }
 
 template <class T> [[nodiscard]] constexpr
@@ -69,7 +73,7 @@ auto speed_to_linear(T v) {
 
 template <class T> [[nodiscard]] constexpr
 auto p_to_ff(T p) -> T {
-	return const_math::pow(T(2), p / T(12));
+	return const_math::exp2(p / T(12));
 }
 
 template <class T> [[nodiscard]] constexpr
@@ -77,4 +81,86 @@ auto ff_to_p(T ff) -> T {
 	return (const_math::log(ff) / const_math::log(T(2))) * T(12);
 }
 
+// The same conversions through tweak::fastmath at the given precision tier,
+// e.g. convert::p_to_ff(p, fastmath::coarse)
+
+template <class T, fastmath::tier Tier> [[nodiscard]]
+auto linear_to_ratio(T v, T max, Tier tier) -> T {
+	if (v <= 0) { return 1.0f; }
+	else        { return T(fastmath::exp2(float(v * v) * fastmath::log2(float(max), tier), tier)); }
+}
+
+template <class T, fastmath::tier Tier> [[nodiscard]]
+auto linear_to_ratio(T v, Tier tier) -> T {
+	return linear_to_ratio(v, T(100), tier);
+}
+
+template <class T, fastmath::tier Tier> [[nodiscard]]
+auto ratio_to_linear(T v, T max, Tier tier) -> T {
+	if (v <= 1) { return 0.0f; }
+	else        { return T(std::sqrt(fastmath::log2(float(v), tier) / fastmath::log2(float(max), tier))); }
+}
+
+template <class T, fastmath::tier Tier> [[nodiscard]]
+auto ratio_to_linear(T v, Tier tier) -> T {
+	return ratio_to_linear(v, T(100), tier);
+}
+
+template <class T, fastmath::tier Tier> [[nodiscard]]
+auto pitch_to_frequency(T v, Tier tier) -> T {
+	return T(8.1758f * fastmath::exp2(float(v) * (1.0f / 12.0f), tier));
+}
+
+template <class T, fastmath::tier Tier> [[nodiscard]]
+auto frequency_to_pitch(T v, Tier tier) -> T {
+	return T(12.0f * fastmath::log2(float(v) * (1.0f / 8.1758f), tier));
+}
+
+template <class T, fastmath::tier Tier> [[nodiscard]]
+auto linear_to_filter_hz(T v, Tier tier) -> T {
+	return pitch_to_frequency(math::lerp(T(-8.513f), T(135.076f), v), tier);
+}
+
+template <class T, fastmath::tier Tier> [[nodiscard]]
+auto filter_hz_to_linear(T v, Tier tier) -> T {
+	return math::inverse_lerp(T(-8.513f), T(135.076f), frequency_to_pitch(v, tier));
+}
+
+// -INF for 0 and below. fastmath::log2 only takes normal numbers, so
+// subnormals are scaled up first.
+template <class T, fastmath::tier Tier> [[nodiscard]]
+auto linear_to_db(T v, Tier tier) -> T {
+	constexpr auto DB_PER_OCTAVE = 6.0205999132796239042f;
+	const auto f = float(v);
+	if (!const_math::isfinite(v))              { return v; }
+	if (!(f > 0.0f))                           { return -std::numeric_limits<T>::infinity(); }
+	if (f < std::numeric_limits<float>::min()) { return T((fastmath::log2(f * 0x1p64f, tier) - 64.0f) * DB_PER_OCTAVE); }
+	return T(fastmath::log2(f, tier) * DB_PER_OCTAVE);
+}
+
+template <class T, fastmath::tier Tier> [[nodiscard]]
+auto db_to_linear(T v, Tier tier) -> T {
+	return const_math::isfinite(v) ? T(fastmath::exp2(float(v) * 0.16609640474436811739f, tier)) : v;
+}
+
+template <class T, fastmath::tier Tier> [[nodiscard]]
+auto linear_to_speed(T v, Tier tier) -> T {
+	return T(fastmath::exp2(float(v), tier));
+}
+
+template <class T, fastmath::tier Tier> [[nodiscard]]
+auto speed_to_linear(T v, Tier tier) -> T {
+	return T(fastmath::log2(float(v), tier));
+}
+
+template <class T, fastmath::tier Tier> [[nodiscard]]
+auto p_to_ff(T p, Tier tier) -> T {
+	return T(fastmath::exp2(float(p) * (1.0f / 12.0f), tier));
+}
+
+template <class T, fastmath::tier Tier> [[nodiscard]]
+auto ff_to_p(T ff, Tier tier) -> T {
+	return T(fastmath::log2(float(ff), tier) * 12.0f);
+}
+
 } // tweak::convert
@@ -0,0 +1,10 @@
+#pragma once
+
+// Consumers linking tweak::tweak_compiled get TWEAK_COMPILED defined. The
+// headers then declare their float and double parsing, formatting and
+// batch functions extern so they are only instantiated once, in the
+// compiled library, which defines TWEAK_EXTERN as nothing before including
+// them.
+#if !defined(TWEAK_EXTERN)
+#	define TWEAK_EXTERN extern
+#endif
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <span>
+
+// exp2, log2, exp and log approximations in three precision tiers, for
+// floats. None of them branch or convert floats to ints, so loops calling
+// them vectorize, and each has a span form which is such a loop.
+//
+// Tiers, by relative error for exp2 and absolute error for log2 of
+// values within an octave of 1:
+//  coarse  about 1e-4, for UI code
+//  medium  about 6e-6
+//  full    about 1.2e-7, two ulps of exp2's result, for DSP
+//
+// log2 further away also rounds its result, to half an ulp of it, e.g.
+// 1e-6 near 20. exp and log add the rounding of the product with LOG2E or
+// LN2, which grows with |x|: up to about 1.5e-6 at 20 for the full tier.
+//
+// Both functions are exact where the answer is a power of two or an
+// integer: exp2 of an integer, log2 of a power of two. log2 and log expect
+// positive normal numbers.
+namespace tweak::fastmath {
+
+struct coarse_t {};
+struct medium_t {};
+struct full_t {};
+
+inline constexpr auto coarse = coarse_t{};
+inline constexpr auto medium = medium_t{};
+inline constexpr auto full   = full_t{};
+
+template <class T>
+concept tier = std::same_as<T, coarse_t> || std::same_as<T, medium_t> || std::same_as<T, full_t>;
+
+namespace detail {
+
+// x with its magnitude limited to 129, leaving NaN alone. Works on the
+// bits, since comparing floats which could be NaN stops GCC vectorizing.
+[[nodiscard]] inline
+auto clamp_exponent(float x) -> float {
+	constexpr auto LIMIT = std::uint32_t(0x43010000); // 129.0f
+	const auto bits = std::bit_cast<std::uint32_t>(x);
+	const auto mag  = bits & 0x7fffffffu;
+	const auto big  = std::uint32_t(0) - std::uint32_t((mag > LIMIT) & (mag <= 0x7f800000u));
+	return std::bit_cast<float>((bits & ~big) | (((bits & 0x80000000u) | LIMIT) & big));
+}
+
+} // detail
+
+inline constexpr auto LOG2E = 1.44269504088896340736f;
+inline constexpr auto LN2   = 0.69314718055994530942f;
+
+// Goes to 0 below -127, including for -INF, and to infinity from 128.
+// Rounds with the 1.5 * 2^23 trick, after clamping x to a range where it
+// holds. From 127.5 x rounds to 128, whose power of two isn't a float, so
+// it is applied as 2^127 * 2.
+template <tier Tier = full_t> [[nodiscard]]
+auto exp2(float x, Tier = {}) -> float {
+	constexpr auto ROUND = 12582912.0f;
+	x = detail::clamp_exponent(x);
+	const auto r = x + ROUND;
+	const auto i = std::min(std::max(std::bit_cast<std::int32_t>(r) - std::bit_cast<std::int32_t>(ROUND), -127), 128);
+	const auto f = x - (r - ROUND); // [-0.5, 0.5]
+	auto p = 0.0f;
+	if constexpr (std::same_as<Tier, coarse_t>) {
+		p = 5.5008903e-2f;
+		p = p * f + 2.4221097e-1f;
+		p = p * f + 6.9328293e-1f;
+	}
+	else if constexpr (std::same_as<Tier, medium_t>) {
+		p = 9.5828507e-3f;
+		p = p * f + 5.5906428e-2f;
+		p = p * f + 2.4024099e-1f;
+		p = p * f + 6.9312419e-1f;
+	}
+	else {
+		// Cephes' exp2f
+		p = 1.535336188319500e-4f;
+		p = p * f + 1.339887440266574e-3f;
+		p = p * f + 9.618437357674640e-3f;
+		p = p * f + 5.550332471162809e-2f;
+		p = p * f + 2.402264791363012e-1f;
+		p = p * f + 6.931472028550421e-1f;
+	}
+	const auto top = std::int32_t(i == 128);
+	return (p * f + 1.0f) * std::bit_cast<float>((i + 127 - top) << 23) * std::bit_cast<float>(0x3f800000 + (top << 23));
+}
+
+template <tier Tier = full_t> [[nodiscard]]
+auto log2(float x, Tier = {}) -> float {
+	// x = m * 2^e with m in [sqrt(0.5), sqrt(2))
+	const auto bits = std::bit_cast<std::int32_t>(x);
+	const auto e    = (bits - 0x3f3504f3) >> 23;
+	const auto m    = std::bit_cast<float>(bits - (e << 23));
+	if constexpr (std::same_as<Tier, coarse_t>) {
+		const auto u = m - 1.0f;
+		auto p = -3.2962751e-1f;
+		p = p * u + 5.1750915e-1f;
+		p = p * u - 7.2490439e-1f;
+		p = p * u + 1.4417606f;
+		return p * u + float(e);
+	}
+	else {
+		// Series in t = (m - 1) / (m + 1), log2(m) = 2 atanh(t) / ln(2)
+		const auto t  = (m - 1.0f) / (m + 1.0f);
+		const auto t2 = t * t;
+		auto p = 0.0f;
+		if constexpr (std::same_as<Tier, medium_t>) {
+			p = 9.8353450e-1f;
+			p = p * t2 + 2.8852286f;
+		}
+		else {
+			p = 4.3425433e-1f;
+			p = p * t2 + 5.7658463e-1f;
+			p = p * t2 + 9.6180076e-1f;
+			p = p * t2 + 2.8853901f;
+		}
+		return p * t + float(e);
+	}
+}
+
+template <tier Tier = full_t> [[nodiscard]]
+auto exp(float x, Tier tier = {}) -> float {
+	return exp2(x * LOG2E, tier);
+}
+
+template <tier Tier = full_t> [[nodiscard]]
+auto log(float x, Tier tier = {}) -> float {
+	return log2(x, tier) * LN2;
+}
+
+// The span forms write min(in.size(), out.size()) values
+template <tier Tier = full_t>
+auto exp2(std::span<const float> in, std::span<float> out, Tier tier = {}) -> void {
+	const auto n = std::min(in.size(), out.size());
+	for (size_t i = 0; i < n; i++) { out[i] = exp2(in[i], tier); }
+}
+
+template <tier Tier = full_t>
+auto log2(std::span<const float> in, std::span<float> out, Tier tier = {}) -> void {
+	const auto n = std::min(in.size(), out.size());
+	for (size_t i = 0; i < n; i++) { out[i] = log2(in[i], tier); }
+}
+
+template <tier Tier = full_t>
+auto exp(std::span<const float> in, std::span<float> out, Tier tier = {}) -> void {
+	const auto n = std::min(in.size(), out.size());
+	for (size_t i = 0; i < n; i++) { out[i] = exp(in[i], tier); }
+}
+
+template <tier Tier = full_t>
+auto log(std::span<const float> in, std::span<float> out, Tier tier = {}) -> void {
+	const auto n = std::min(in.size(), out.size());
+	for (size_t i = 0; i < n; i++) { out[i] = log(in[i], tier); }
+}
+
+} // tweak::fastmath
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include "lut.hpp"
+
+// Q15 and Q31 fixed point versions of the math and conversions, for targets
+// without floating point.
+//
+// Everything is integer arithmetic on tables built at compile time, with
+// rounding done by adding half and shifting right, so results are bit
+// exact on every platform. Results saturate to the range of the type.
+//
+// A Q15 value q stands for q / 2^15 and a Q31 value for q / 2^31, in
+// [-1, 1). The conversions work in these units:
+//  dB          q * DB_SCALE, so [-128, 128) dB
+//  gain        q * GAIN_SCALE, so [-16, 16), up to +24 dB
+//  semitones   q * PITCH_SCALE, so [-256, 256)
+//  Hz          q * HZ_SCALE, so [-32768, 32768) and whole Hz in Q15
+//
+// The conversions go through exp2 and log2 with 24 fraction bits of
+// octaves, each a linear interpolation between 1025 table entries with 30
+// fraction bits. Results are within half a step of the exact value for the
+// input, plus the error of the interpolation and the rounded constants:
+//  db_to_linear, pitch_to_frequency, p_to_ff  2.5e-7 of the result
+//  linear_to_db                               3e-6 dB
+//  frequency_to_pitch, ff_to_p                8e-6 semitones
+// In Q15 that adds less than 0.003 of a step. In Q31 it is most of the
+// error where results are large, e.g. 160 steps of gain at +24 dB, and
+// half a step is most of it where they are small: a Q31 gain at -120 dB
+// is only within 4e-3 relative.
+namespace tweak::fixed {
+
+using q15 = std::int16_t;
+using q31 = std::int32_t;
+
+template <class Q>
+concept q_type = std::same_as<Q, q15> || std::same_as<Q, q31>;
+
+template <q_type Q> inline constexpr auto FRACTION_BITS = int(sizeof(Q) * 8 - 1);
+
+inline constexpr auto DB_SCALE    = 128;
+inline constexpr auto GAIN_SCALE  = 16;
+inline constexpr auto PITCH_SCALE = 256;
+inline constexpr auto HZ_SCALE    = 32768;
+
+inline constexpr auto TABLE_BITS = 10;
+inline constexpr auto TABLE_SIZE = 1 << TABLE_BITS;
+
+namespace detail {
+
+[[nodiscard]] constexpr
+auto make_exp2_table() {
+	auto out = std::array<std::int64_t, TABLE_SIZE + 1>{};
+	for (auto i = 0; i <= TABLE_SIZE; i++) {
+		out[i] = static_cast<std::int64_t>(lut::series_exp(0.69314718055994530942 * i / TABLE_SIZE) * double(1 << 30) + 0.5);
+	}
+	return out;
+}
+
+[[nodiscard]] constexpr
+auto make_log2_table() {
+	auto out = std::array<std::int64_t, TABLE_SIZE + 1>{};
+	for (auto i = 0; i <= TABLE_SIZE; i++) {
+		out[i] = static_cast<std::int64_t>(lut::series_log(1.0 + double(i) / TABLE_SIZE) / 0.69314718055994530942 * double(1 << 30) + 0.5);
+	}
+	return out;
+}
+
+// 2^(i/TABLE_SIZE) and log2(1 + i/TABLE_SIZE), with 30 fraction bits
+inline constexpr auto EXP2_TABLE = make_exp2_table();
+inline constexpr auto LOG2_TABLE = make_log2_table();
+
+// v / 2^shift rounded to nearest, for shift > 0
+[[nodiscard]] constexpr
+auto round_shift(std::int64_t v, int shift) -> std::int64_t {
+	return (v + (std::int64_t(1) << (shift - 1))) >> shift;
+}
+
+template <q_type Q> [[nodiscard]] constexpr
+auto saturate(std::int64_t v) -> Q {
+	if (v < std::numeric_limits<Q>::min()) { return std::numeric_limits<Q>::min(); }
+	if (v > std::numeric_limits<Q>::max()) { return std::numeric_limits<Q>::max(); }
+	return static_cast<Q>(v);
+}
+
+// 2^x for x with 24 fraction bits, as a value with `frac` fraction bits.
+// Values too large for 62 bits come back as INT64_MAX.
+[[nodiscard]] constexpr
+auto exp2(std::int32_t x, int frac) -> std::int64_t {
+	constexpr auto T_BITS = 24 - TABLE_BITS;
+	const auto octave = x >> 24;
+	const auto f      = x & 0xffffff;
+	const auto i      = f >> T_BITS;
+	const auto t      = std::int64_t(f & ((1 << T_BITS) - 1));
+	const auto m      = EXP2_TABLE[i] + round_shift((EXP2_TABLE[i + 1] - EXP2_TABLE[i]) * t, T_BITS);
+	const auto shift  = octave + frac - 30;
+	if (shift > 31)  { return std::numeric_limits<std::int64_t>::max(); }
+	if (shift >= 0)  { return m << shift; }
+	if (shift < -40) { return 0; }
+	return round_shift(m, -shift);
+}
+
+// log2(v / 2^frac) with 24 fraction bits, for v > 0
+[[nodiscard]] constexpr
+auto log2(std::uint64_t v, int frac) -> std::int32_t {
+	constexpr auto T_BITS = 23 - TABLE_BITS;
+	const auto msb  = 63 - std::countl_zero(v);
+	const auto norm = msb >= 23 ? v >> (msb - 23) : v << (23 - msb); // [2^23, 2^24)
+	const auto f    = static_cast<std::int32_t>(norm - (std::uint64_t(1) << 23));
+	const auto i    = f >> T_BITS;
+	const auto t    = std::int64_t(f & ((1 << T_BITS) - 1));
+	const auto l    = LOG2_TABLE[i] + round_shift((LOG2_TABLE[i + 1] - LOG2_TABLE[i]) * t, T_BITS);
+	return static_cast<std::int32_t>((std::int64_t(msb - frac) << 24) + round_shift(l, 6));
+}
+
+// v * k / 2^shift, rounded
+[[nodiscard]] constexpr
+auto mul_shift(std::int64_t v, std::int64_t k, int shift) -> std::int64_t {
+	return round_shift(v * k, shift);
+}
+
+// Multipliers from units to octaves with 24 fraction bits, and from octaves
+// to units with 32
+inline constexpr auto DB_TO_LOG2    = std::int64_t(356689313); // DB_SCALE * log2(10) / 20
+inline constexpr auto PITCH_TO_LOG2 = std::int64_t(357913941); // PITCH_SCALE / 12
+inline constexpr auto LOG2_TO_DB    = std::int64_t(202017810); // 20 / log2(10) / DB_SCALE
+inline constexpr auto LOG2_TO_PITCH = std::int64_t(201326592); // 12 / PITCH_SCALE
+inline constexpr auto LOG2_C0       = std::int64_t(50857780);  // log2(8.1758), with 24 fraction bits
+
+} // detail
+
+template <q_type Q> [[nodiscard]] constexpr
+auto to_fixed(float v) -> Q {
+	const auto scaled = double(v) * double(std::int64_t(1) << FRACTION_BITS<Q>);
+	return detail::saturate<Q>(static_cast<std::int64_t>(scaled < 0.0 ? scaled - 0.5 : scaled + 0.5));
+}
+
+template <q_type Q> [[nodiscard]] constexpr
+auto to_float(Q v) -> float {
+	return float(double(v) / double(std::int64_t(1) << FRACTION_BITS<Q>));
+}
+
+template <q_type Q> [[nodiscard]] constexpr
+auto lerp(Q a, Q b, Q x) -> Q {
+	return detail::saturate<Q>(a + detail::round_shift((std::int64_t(b) - a) * x, FRACTION_BITS<Q>));
+}
+
+// Saturates to [-1, 1) outside [a, b], and is 0 if a == b
+template <q_type Q> [[nodiscard]] constexpr
+auto inverse_lerp(Q a, Q b, Q x) -> Q {
+	const auto num = std::int64_t(x) - a;
+	const auto den = std::int64_t(b) - a;
+	if (den == 0) { return 0; }
+	if ((num < 0 ? -num : num) >= (den < 0 ? -den : den)) { return detail::saturate<Q>((num < 0) == (den < 0) ? std::numeric_limits<Q>::max() : std::numeric_limits<Q>::min()); }
+	const auto scaled = num << FRACTION_BITS<Q>;
+	const auto half   = ((scaled < 0) == (den < 0) ? den : -den) / 2;
+	return detail::saturate<Q>((scaled + half) / den);
+}
+
+// v rounded to the nearest multiple of step, halves rounding up
+template <q_type Q> [[nodiscard]] constexpr
+auto stepify(Q v, Q step) -> Q {
+	if (step <= 0) { return v; }
+	const auto n = std::int64_t(v) + step / 2;
+	const auto k = n >= 0 ? n / step : -((-n + step - 1) / step);
+	return detail::saturate<Q>(k * step);
+}
+
+template <q_type Q> [[nodiscard]] constexpr
+auto constrain(Q v, Q min, Q max) -> Q {
+	if (v < min) { return min; }
+	if (v > max) { return max; }
+	return v;
+}
+
+template <q_type Q> [[nodiscard]] constexpr
+auto db_to_linear(Q db) -> Q {
+	const auto x = detail::mul_shift(db, detail::DB_TO_LOG2, FRACTION_BITS<Q>);
+	return detail::saturate<Q>(detail::exp2(static_cast<std::int32_t>(x), FRACTION_BITS<Q> - 4));
+}
+
+// The lowest value for silence
+template <q_type Q> [[nodiscard]] constexpr
+auto linear_to_db(Q linear) -> Q {
+	if (linear <= 0) { return std::numeric_limits<Q>::min(); }
+	const auto l = detail::log2(std::uint64_t(linear), FRACTION_BITS<Q> - 4);
+	return detail::saturate<Q>(detail::mul_shift(l, detail::LOG2_TO_DB, 56 - FRACTION_BITS<Q>));
+}
+
+template <q_type Q> [[nodiscard]] constexpr
+auto pitch_to_frequency(Q pitch) -> Q {
+	const auto x = detail::LOG2_C0 + detail::mul_shift(pitch, detail::PITCH_TO_LOG2, FRACTION_BITS<Q>);
+	return detail::saturate<Q>(detail::exp2(static_cast<std::int32_t>(x), FRACTION_BITS<Q> - 15));
+}
+
+template <q_type Q> [[nodiscard]] constexpr
+auto frequency_to_pitch(Q hz) -> Q {
+	if (hz <= 0) { return std::numeric_limits<Q>::min(); }
+	const auto l = detail::log2(std::uint64_t(hz), FRACTION_BITS<Q> - 15) - detail::LOG2_C0;
+	return detail::saturate<Q>(detail::mul_shift(l, detail::LOG2_TO_PITCH, 56 - FRACTION_BITS<Q>));
+}
+
+// Semitones to a frequency factor, in gain units
+template <q_type Q> [[nodiscard]] constexpr
+auto p_to_ff(Q p) -> Q {
+	const auto x = detail::mul_shift(p, detail::PITCH_TO_LOG2, FRACTION_BITS<Q>);
+	return detail::saturate<Q>(detail::exp2(static_cast<std::int32_t>(x), FRACTION_BITS<Q> - 4));
+}
+
+template <q_type Q> [[nodiscard]] constexpr
+auto ff_to_p(Q ff) -> Q {
+	if (ff <= 0) { return std::numeric_limits<Q>::min(); }
+	const auto l = detail::log2(std::uint64_t(ff), FRACTION_BITS<Q> - 4);
+	return detail::saturate<Q>(detail::mul_shift(l, detail::LOG2_TO_PITCH, 56 - FRACTION_BITS<Q>));
+}
+
+} // tweak::fixed
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace tweak {
+
+namespace detail {
+
+// Numbers which append() formats. bool and the character types are left
+// out, except signed and unsigned char which are int8_t and uint8_t.
+template <class T>
+concept formattable_number =
+	std::is_arithmetic_v<T> &&
+	!std::same_as<T, bool> &&
+	!std::same_as<T, char> &&
+	!std::same_as<T, wchar_t> &&
+	!std::same_as<T, char8_t> &&
+	!std::same_as<T, char16_t> &&
+	!std::same_as<T, char32_t>;
+
+} // detail
+
+// Fixed capacity string used by the non-allocating formatters. Anything
+// that doesn't fit is silently truncated.
+template <size_t N>
+struct fixed_string {
+	constexpr fixed_string() = default;
+	constexpr fixed_string(std::string_view s) { append(s); }
+	[[nodiscard]] static constexpr auto capacity() -> size_t { return N; }
+	[[nodiscard]] constexpr auto data() const -> const char* { return chars_.data(); }
+	[[nodiscard]] constexpr auto size() const -> size_t { return size_; }
+	[[nodiscard]] constexpr auto empty() const -> bool { return size_ == 0; }
+	[[nodiscard]] constexpr auto view() const -> std::string_view { return {chars_.data(), size_}; }
+	[[nodiscard]] constexpr operator std::string_view() const { return view(); }
+	[[nodiscard]] auto str() const -> std::string { return std::string{view()}; }
+	constexpr auto clear() -> void { size_ = 0; }
+	constexpr auto append(std::string_view s) -> fixed_string& {
+		for (const auto c : s) {
+			if (size_ == N) { break; }
+			chars_[size_++] = c;
+		}
+		return *this;
+	}
+	template <std::same_as<char> C>
+	constexpr auto append(C c) -> fixed_string& {
+		if (size_ < N) { chars_[size_++] = c; }
+		return *this;
+	}
+	template <detail::formattable_number T>
+	auto append(T v) -> fixed_string& {
+		auto result = std::to_chars_result{};
+		if constexpr (std::is_floating_point_v<T>) {
+			// Same output as the default std::ostream formatting (%g)
+			result = std::to_chars(chars_.data() + size_, chars_.data() + N, v, std::chars_format::general, 6);
+		}
+		else {
+			result = std::to_chars(chars_.data() + size_, chars_.data() + N, v);
+		}
+		if (result.ec == std::errc{}) { size_ = static_cast<size_t>(result.ptr - chars_.data()); }
+		return *this;
+	}
+	// Shortest output that parses back to exactly v
+	template <class T> requires std::is_floating_point_v<T>
+	auto append_exact(T v) -> fixed_string& {
+		const auto result = std::to_chars(chars_.data() + size_, chars_.data() + N, v);
+		if (result.ec == std::errc{}) { size_ = static_cast<size_t>(result.ptr - chars_.data()); }
+		return *this;
+	}
+	[[nodiscard]] friend constexpr auto operator==(const fixed_string& a, std::string_view b) -> bool {
+		return a.view() == b;
+	}
+private:
+	std::array<char, N> chars_ = {};
+	size_t size_ = 0;
+};
+
+using label = fixed_string<32>;
+
+} // tweak
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <concepts>
+#include <limits>
+#include "const-math.hpp"
+
+namespace tweak::lut {
+
+// Table resolution per octave. Linear interpolation between entries adds
+// around 1e-7 of error, so float results are within a couple of ulps.
+inline constexpr auto SIZE = 1024;
+
+// Double precision series used to build the tables. const_math is only
+// accurate to about float precision, which isn't enough here.
+[[nodiscard]] constexpr
+auto series_exp(double x) -> double {
+	auto sum  = 1.0;
+	auto term = 1.0;
+	for (auto n = 1; n < 40 && const_math::abs(term) > 1e-18; n++) {
+		term *= x / n;
+		sum  += term;
+	}
+	return sum;
+}
+
+// Natural log for x in [1, 2]
+[[nodiscard]] constexpr
+auto series_log(double x) -> double {
+	const auto y  = (x - 1.0) / (x + 1.0);
+	const auto y2 = y * y;
+	auto sum  = 0.0;
+	auto term = y;
+	for (auto n = 1; n < 80 && term > 1e-18; n += 2) {
+		sum  += term / n;
+		term *= y2;
+	}
+	return 2.0 * sum;
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto make_exp2_table() {
+	auto out = std::array<T, SIZE + 2>{};
+	for (auto i = 0; i < SIZE + 2; i++) {
+		out[i] = T(series_exp(0.69314718055994530942 * i / SIZE));
+	}
+	return out;
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto make_log2_table() {
+	auto out = std::array<T, SIZE + 2>{};
+	for (auto i = 0; i < SIZE + 2; i++) {
+		out[i] = T(series_log(1.0 + double(i) / SIZE) / 0.69314718055994530942);
+	}
+	return out;
+}
+
+// 2^(i/SIZE) and log2(1 + i/SIZE), with one extra entry so interpolation
+// never reads past the end.
+template <std::floating_point T> inline constexpr auto EXP2_TABLE = make_exp2_table<T>();
+template <std::floating_point T> inline constexpr auto LOG2_TABLE = make_log2_table<T>();
+
+template <std::floating_point T> [[nodiscard]]
+auto exp2(T x) -> T {
+	if (!(x == x))                                      { return x; }
+	if (x >= T(std::numeric_limits<T>::max_exponent))   { return std::numeric_limits<T>::infinity(); }
+	if (x <= T(std::numeric_limits<T>::min_exponent - 1)) { return std::exp2(x); }
+	const auto octave = std::floor(x);
+	const auto pos    = (x - octave) * T(SIZE);
+	const auto index  = static_cast<int>(pos);
+	const auto t      = pos - T(index);
+	const auto& table = EXP2_TABLE<T>;
+	return std::ldexp(table[index] + (table[index + 1] - table[index]) * t, static_cast<int>(octave));
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto log2(T x) -> T {
+	if (!(x > T(0)))                              { return x == T(0) ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::quiet_NaN(); }
+	if (x == std::numeric_limits<T>::infinity()) { return x; }
+	auto exponent     = 0;
+	const auto m      = std::frexp(x, &exponent);
+	const auto pos    = (m * T(2) - T(1)) * T(SIZE);
+	const auto index  = static_cast<int>(pos);
+	const auto t      = pos - T(index);
+	const auto& table = LOG2_TABLE<T>;
+	return T(exponent - 1) + table[index] + (table[index + 1] - table[index]) * t;
+}
+
+} // tweak::lut
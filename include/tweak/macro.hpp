@@ -0,0 +1,125 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+#include "any-param.hpp"
+#include "math.hpp"
+
+namespace tweak::macro {
+
+// Rows in a mapping's response table. Values between rows are linear
+// interpolations of the exact values at the rows, so with 256 rows a
+// frequency spanning the whole audible range is within about 0.01% of the
+// exact response.
+inline constexpr auto TABLE_SIZE = size_t(256);
+
+struct target {
+	std::uint32_t param; // Index of the parameter in the caller's list
+	param_kind kind;
+	float from;          // Value at macro position 0
+	float to;            // Value at macro position 1
+	float curve = 1.0f;  // Exponent applied to the macro position, 1 for linear
+};
+
+namespace detail {
+
+// All bits set if v is finite. The difference of two rows is INF or NaN
+// when either row isn't finite.
+[[nodiscard]] inline
+auto finite_mask(float v) -> std::uint32_t {
+	return std::uint32_t(0) - std::uint32_t((std::bit_cast<std::uint32_t>(v) & 0x7f800000u) != 0x7f800000u);
+}
+
+// a where mask is set, b where it isn't. Blending with bitwise operations
+// keeps the row loop vectorizable.
+[[nodiscard]] inline
+auto select(std::uint32_t mask, float a, float b) -> float {
+	return std::bit_cast<float>((std::bit_cast<std::uint32_t>(a) & mask) | (std::bit_cast<std::uint32_t>(b) & ~mask));
+}
+
+} // detail
+
+// One macro knob driving any number of parameters. Each target moves from
+// `from` to `to` in its policy's normalized domain, shaped by its curve.
+// The responses are worked out once, when the mapping is made, into a
+// table with one row of target values per macro position. Moving the
+// macro interpolates linearly between two contiguous rows of values, a
+// loop the compiler vectorizes, with no conversions. Where either row is
+// not finite, e.g. a ratio of INF, the nearer row is used instead.
+struct mapping {
+	mapping(std::vector<target> targets) : targets_{std::move(targets)} {
+		const auto n = size();
+		table_.resize((TABLE_SIZE + 1) * n);
+		values_.resize(n);
+		for (size_t k = 0; k < n; k++) {
+			const auto& t = targets_[k];
+			visit(t.kind, [this, &t, k, n](const auto& p) {
+				const auto from = p.to_normalized(p.constrain(t.from));
+				const auto to   = p.to_normalized(p.constrain(t.to));
+				for (size_t row = 0; row <= TABLE_SIZE; row++) {
+					const auto x = std::pow(float(row) / float(TABLE_SIZE), t.curve);
+					table_[row * n + k] = p.constrain(p.from_normalized(math::lerp(from, to, x)));
+				}
+			});
+		}
+	}
+	[[nodiscard]] auto size() const -> size_t { return targets_.size(); }
+	[[nodiscard]] auto targets() const -> std::span<const target> { return targets_; }
+	// The position last passed to set(), NaN before the first call
+	[[nodiscard]] auto position() const -> float { return position_; }
+	// Writes each target's value at macro position m, clamped to [0, 1], to
+	// out, which holds one value per target. NaN counts as 0.
+	auto process(float m, std::span<float> out) const -> void {
+		const auto n   = std::min(size(), out.size());
+		const auto pos = std::min(std::max(0.0f, m), 1.0f) * float(TABLE_SIZE);
+		const auto row = std::min(static_cast<size_t>(pos), TABLE_SIZE - 1);
+		const auto x   = pos - float(row);
+		const auto* a  = table_.data() + row * size();
+		const auto* b  = a + size();
+		const auto* c  = x < 0.5f ? a : b;
+		auto* o        = out.data();
+		for (size_t k = 0; k < n; k++) {
+			const auto d = b[k] - a[k];
+			o[k] = detail::select(detail::finite_mask(d), a[k] + d * x, c[k]);
+		}
+	}
+	// Audio rate, e.g. for a macro driven by an LFO. positions holds one
+	// macro position per frame and out one row of target values per frame.
+	auto process(std::span<const float> positions, std::span<float> out) const -> void {
+		if (size() == 0) { return; }
+		const auto frames = std::min(positions.size(), out.size() / size());
+		for (size_t f = 0; f < frames; f++) {
+			process(positions[f], out.subspan(f * size(), size()));
+		}
+	}
+	// Moves the macro, writing each target's value to its parameter in
+	// params and setting its flag in dirty if the value changed. Returns
+	// false, doing nothing, if the macro hasn't moved. Targets whose index
+	// is outside params or dirty are skipped.
+	auto set(float m, std::span<any_param> params, std::span<std::uint8_t> dirty) -> bool {
+		if (m == position_) { return false; }
+		position_ = m;
+		process(m, values_);
+		for (size_t k = 0; k < size(); k++) {
+			const auto index = targets_[k].param;
+			if (index >= params.size() || index >= dirty.size()) { continue; }
+			auto& param     = params[index];
+			const auto prev = param.value();
+			param.set(values_[k]);
+			if (param.value() != prev) { dirty[index] = 1; }
+		}
+		return true;
+	}
+private:
+	std::vector<target> targets_;
+	std::vector<float> table_; // TABLE_SIZE + 1 rows of one value per target
+	std::vector<float> values_;
+	float position_ = std::numeric_limits<float>::quiet_NaN();
+};
+
+} // tweak::macro
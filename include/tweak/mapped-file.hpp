@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <utility>
+
+#if defined(_WIN32)
+#	if !defined(WIN32_LEAN_AND_MEAN)
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	if !defined(NOMINMAX)
+#		define NOMINMAX
+#	endif
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace tweak {
+
+// Read only memory map of a whole file. bytes() is empty if the file
+// couldn't be opened or is empty.
+struct mapped_file {
+	mapped_file() = default;
+	mapped_file(const std::filesystem::path& path) { open(path); }
+	mapped_file(const mapped_file&) = delete;
+	mapped_file(mapped_file&& rhs) noexcept : data_{std::exchange(rhs.data_, nullptr)}, size_{std::exchange(rhs.size_, 0)} {}
+	auto operator=(const mapped_file&) -> mapped_file& = delete;
+	auto operator=(mapped_file&& rhs) noexcept -> mapped_file& {
+		if (this != &rhs) {
+			close();
+			data_ = std::exchange(rhs.data_, nullptr);
+			size_ = std::exchange(rhs.size_, 0);
+		}
+		return *this;
+	}
+	~mapped_file() { close(); }
+	[[nodiscard]] auto is_open() const -> bool { return data_ != nullptr; }
+	[[nodiscard]] auto bytes() const -> std::span<const std::byte> { return {static_cast<const std::byte*>(data_), size_}; }
+	auto open(const std::filesystem::path& path) -> bool {
+		close();
+#if defined(_WIN32)
+		const auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) { return false; }
+		auto size = LARGE_INTEGER{};
+		if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+			CloseHandle(file);
+			return false;
+		}
+		const auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(file);
+		if (!mapping) { return false; }
+		data_ = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		CloseHandle(mapping);
+		if (!data_) { return false; }
+		size_ = static_cast<size_t>(size.QuadPart);
+#else
+		const auto fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) { return false; }
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size == 0) {
+			::close(fd);
+			return false;
+		}
+		const auto data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if (data == MAP_FAILED) { return false; }
+		data_ = data;
+		size_ = static_cast<size_t>(st.st_size);
+#endif
+		return true;
+	}
+	auto close() -> void {
+		if (!data_) { return; }
+#if defined(_WIN32)
+		UnmapViewOfFile(data_);
+#else
+		munmap(data_, size_);
+#endif
+		data_ = nullptr;
+		size_ = 0;
+	}
+private:
+	void* data_  = nullptr;
+	size_t size_ = 0;
+};
+
+} // tweak
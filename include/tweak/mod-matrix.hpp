@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include "any-param.hpp"
+
+namespace tweak {
+
+// Many to many modulation of a set of destination parameters, per voice,
+// a block at a time. Each route adds a source scaled by its depth to a
+// destination in the destination policy's normalized domain, on top of the
+// voice's base value for that destination. Depth 1 sweeps the whole range
+// of the destination for a source moving from 0 to 1.
+//
+// Routes are stored as separate arrays of sources, destinations and
+// depths. Each one is a multiply-add loop over a block of frames, which the
+// compiler vectorizes. The sums are then converted to values once per frame
+// per destination through a table for each kind of destination. The tables
+// hold constrained values, computed when the matrix is made. Destinations
+// without a route are converted once per block.
+struct mod_matrix {
+	static constexpr auto TABLE_SIZE = size_t(1024);
+	// Frames are summed max_frames at a time, so process() never allocates
+	mod_matrix(std::span<const param_kind> destinations, size_t sources, size_t voices, size_t max_frames = 256)
+		: kinds_{destinations.begin(), destinations.end()}
+		, sources_{sources}
+		, voices_{voices}
+		, max_frames_{std::max(max_frames, size_t(1))}
+		, base_(voices * destinations.size(), 0.0f)
+		, sum_(destinations.size() * max_frames_, 0.0f)
+		, modulated_(destinations.size(), 0)
+	{
+		for (const auto kind : kinds_) {
+			const auto pos = std::find(table_kinds_.begin(), table_kinds_.end(), kind);
+			if (pos != table_kinds_.end()) {
+				table_.push_back(static_cast<std::uint32_t>(pos - table_kinds_.begin()) * (TABLE_SIZE + 1));
+				continue;
+			}
+			table_.push_back(static_cast<std::uint32_t>(tables_.size()));
+			table_kinds_.push_back(kind);
+			visit(kind, [this](const auto& p) {
+				for (size_t i = 0; i <= TABLE_SIZE; i++) {
+					tables_.push_back(p.constrain(p.from_normalized(float(i) / float(TABLE_SIZE))));
+				}
+			});
+		}
+		for (size_t d = 0; d < kinds_.size(); d++) {
+			const auto v = visit(kinds_[d], [](const auto& p) { return p.to_normalized(p.DEFAULT); });
+			for (size_t voice = 0; voice < voices_; voice++) {
+				base_[voice * kinds_.size() + d] = v;
+			}
+		}
+	}
+	[[nodiscard]] auto destinations() const -> size_t { return kinds_.size(); }
+	[[nodiscard]] auto sources() const -> size_t { return sources_; }
+	[[nodiscard]] auto voices() const -> size_t { return voices_; }
+	[[nodiscard]] auto routes() const -> size_t { return depth_.size(); }
+	// Returns the index of the new route, or nullopt, adding nothing, if
+	// source or destination is out of range
+	auto connect(size_t source, size_t destination, float depth) -> std::optional<size_t> {
+		if (source >= sources_ || destination >= destinations()) { return std::nullopt; }
+		source_.push_back(static_cast<std::uint32_t>(source));
+		destination_.push_back(static_cast<std::uint32_t>(destination));
+		depth_.push_back(depth);
+		return routes() - 1;
+	}
+	auto set_depth(size_t route, float depth) -> void { depth_[route] = depth; }
+	auto clear() -> void {
+		source_.clear();
+		destination_.clear();
+		depth_.clear();
+	}
+	// The unmodulated value of a destination for a voice. Does nothing if
+	// either is out of range.
+	auto set_base(size_t voice, size_t destination, float value) -> void {
+		if (voice >= voices_ || destination >= destinations()) { return; }
+		base_[voice * destinations() + destination] = visit(kinds_[destination], [value](const auto& p) { return p.to_normalized(p.constrain(value)); });
+	}
+	// sources holds `frames` values for each source, one source after
+	// another, and out gets `frames` values for each destination in the
+	// same way. If either is too short for that, only the frames which the
+	// last source or destination has are processed. Nothing is written if
+	// voice is out of range.
+	auto process(size_t voice, std::span<const float> sources, size_t frames, std::span<float> out) -> void {
+		const auto dests = destinations();
+		if (dests == 0 || voice >= voices_) { return; }
+		const auto available = [frames](size_t size, size_t rows) {
+			const auto before = (rows - 1) * frames;
+			return size > before ? std::min(frames, size - before) : size_t(0);
+		};
+		auto n = available(out.size(), dests);
+		if (sources_ > 0) { n = std::min(n, available(sources.size(), sources_)); }
+		const auto* base = base_.data() + voice * dests;
+		for (size_t start = 0; start < n; start += max_frames_) {
+			const auto count = std::min(max_frames_, n - start);
+			std::fill(modulated_.begin(), modulated_.end(), std::uint8_t(0));
+			for (size_t r = 0; r < routes(); r++) {
+				const auto depth = depth_[r];
+				if (depth == 0.0f) { continue; }
+				if (!modulated_[destination_[r]]) {
+					std::fill_n(sum_.begin() + destination_[r] * max_frames_, count, base[destination_[r]]);
+					modulated_[destination_[r]] = 1;
+				}
+				const auto* src = sources.data() + source_[r] * frames + start;
+				auto* dst       = sum_.data() + destination_[r] * max_frames_;
+				for (size_t f = 0; f < count; f++) {
+					dst[f] += depth * src[f];
+				}
+			}
+			for (size_t d = 0; d < dests; d++) {
+				const auto* table = tables_.data() + table_[d];
+				auto* dst         = out.data() + d * frames + start;
+				if (!modulated_[d]) {
+					std::fill_n(dst, count, lookup(table, base[d]));
+					continue;
+				}
+				const auto* sum = sum_.data() + d * max_frames_;
+				for (size_t f = 0; f < count; f++) {
+					dst[f] = lookup(table, sum[f]);
+				}
+			}
+		}
+	}
+private:
+	// Entries which aren't finite, such as a ratio's INF, are used as they
+	// are by the nearer side of the interval next to them
+	[[nodiscard]] static auto lookup(const float* table, float v) -> float {
+		const auto n   = std::min(std::max(0.0f, v), 1.0f); // NaN goes to 0
+		const auto pos = n * float(TABLE_SIZE);
+		const auto i   = std::min(static_cast<std::int32_t>(pos), std::int32_t(TABLE_SIZE - 1));
+		const auto x   = pos - float(i);
+		const auto d   = table[i + 1] - table[i];
+		if (!std::isfinite(d)) { return x < 0.5f ? table[i] : table[i + 1]; }
+		return table[i] + d * x;
+	}
+	std::vector<param_kind> kinds_;
+	size_t sources_;
+	size_t voices_;
+	size_t max_frames_;
+	std::vector<std::uint32_t> source_;
+	std::vector<std::uint32_t> destination_;
+	std::vector<float> depth_;
+	std::vector<float> base_;   // Normalized, one row of destinations per voice
+	std::vector<float> sum_;    // One row of max_frames_ per destination
+	std::vector<std::uint8_t> modulated_; // Destinations with a route in the current block
+	std::vector<float> tables_; // TABLE_SIZE + 1 values for each kind of destination
+	std::vector<std::uint32_t> table_; // Offset of each destination's table
+	std::vector<param_kind> table_kinds_;
+};
+
+} // tweak
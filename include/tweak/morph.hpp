@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <vector>
+#include "any-param.hpp"
+
+namespace tweak::morph {
+
+// Blends any number of presets with weights, e.g. from the corners of an
+// XY pad. Each parameter is blended in its policy's normalized domain,
+// which is dB for amp, pitch for frequency, octaves for speed and ms and
+// so on, so a halfway morph sounds halfway.
+//
+// Presets are converted to that domain when they are set, so a blend is
+// one multiply-add loop over contiguous rows per preset, which the
+// compiler vectorizes, then one conversion back per parameter, grouped by
+// policy.
+struct engine {
+	engine(std::span<const param_kind> kinds, size_t presets)
+		: kinds_{kinds.begin(), kinds.end()}
+		, index_{std::span<const param_kind>{kinds_}}
+		, normalized_(kinds.size() * presets, 0.0f)
+		, sum_(kinds.size(), 0.0f)
+		, presets_{presets}
+	{}
+	[[nodiscard]] auto parameters() const -> size_t { return kinds_.size(); }
+	[[nodiscard]] auto presets() const -> size_t { return presets_; }
+	// values holds one value per parameter
+	auto set_preset(size_t preset, std::span<const float> values) -> void {
+		const auto row = std::span{normalized_}.subspan(preset * parameters(), parameters());
+		batch::for_each(std::span<const param_kind>{kinds_}, index_, [values, row](const auto& p, size_t i) {
+			row[i] = p.to_normalized(p.constrain(values[i]));
+		});
+	}
+	// Writes the blend to out, which must hold a value per parameter and is
+	// typically a smoother's target values. Weights are relative, one per
+	// preset, and negative weights count as zero. Nothing is written if they
+	// are all zero.
+	auto process(std::span<const float> weights, std::span<float> out) -> void {
+		const auto count = std::min(weights.size(), presets());
+		auto total = 0.0f;
+		for (size_t k = 0; k < count; k++) {
+			total += std::max(weights[k], 0.0f);
+		}
+		if (total <= 0.0f) { return; }
+		std::fill(sum_.begin(), sum_.end(), 0.0f);
+		const auto n = parameters();
+		for (size_t k = 0; k < count; k++) {
+			const auto w = std::max(weights[k], 0.0f) / total;
+			if (w == 0.0f) { continue; }
+			const auto* row = normalized_.data() + k * n;
+			auto* sum       = sum_.data();
+			for (size_t i = 0; i < n; i++) {
+				sum[i] += w * row[i];
+			}
+		}
+		batch::for_each(std::span<const param_kind>{kinds_}, index_, [this, out](const auto& p, size_t i) {
+			out[i] = p.from_normalized(sum_[i]);
+		});
+	}
+private:
+	std::vector<param_kind> kinds_;
+	kind_index index_;
+	std::vector<float> normalized_; // One row of parameters per preset
+	std::vector<float> sum_;
+	size_t presets_;
+};
+
+} // tweak::morph
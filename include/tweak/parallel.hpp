@@ -0,0 +1,180 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace tweak {
+
+namespace detail {
+
+[[nodiscard]] inline
+auto thread_count(size_t threads) -> size_t {
+	return threads > 0 ? threads : std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+}
+
+} // detail
+
+// Worker threads kept alive between jobs so that repeated parallel loops
+// don't start new threads each time. The thread calling run() takes part
+// in the job as thread 0. Jobs from different threads run one at a time.
+struct thread_pool {
+	// threads counts the calling thread, 0 for one per core
+	explicit thread_pool(size_t threads = 0) {
+		const auto n = detail::thread_count(threads);
+		workers_.reserve(n - 1);
+		for (size_t t = 1; t < n; t++) {
+			workers_.emplace_back([this, t] { work(t); });
+		}
+	}
+	thread_pool(const thread_pool&) = delete;
+	auto operator=(const thread_pool&) -> thread_pool& = delete;
+	~thread_pool() {
+		{
+			auto lock = std::lock_guard{mutex_};
+			stop_ = true;
+		}
+		wake_.notify_all();
+		workers_.clear();
+	}
+	[[nodiscard]] auto size() const -> size_t { return workers_.size() + 1; }
+	// Calls fn(t) once on each thread t in [0, size()) and returns when all
+	// the calls have returned
+	template <class Fn>
+	auto run(Fn&& fn) -> void {
+		auto job_lock = std::lock_guard{job_mutex_};
+		{
+			auto lock = std::lock_guard{mutex_};
+			job_     = [](void* context, size_t t) { (*static_cast<std::remove_reference_t<Fn>*>(context))(t); };
+			context_ = const_cast<void*>(static_cast<const void*>(&fn));
+			busy_    = workers_.size();
+			generation_++;
+		}
+		wake_.notify_all();
+		fn(size_t(0));
+		auto lock = std::unique_lock{mutex_};
+		done_.wait(lock, [this] { return busy_ == 0; });
+	}
+private:
+	auto work(size_t self) -> void {
+		auto seen = size_t(0);
+		for (;;) {
+			auto lock = std::unique_lock{mutex_};
+			wake_.wait(lock, [this, seen] { return stop_ || generation_ != seen; });
+			if (stop_) { return; }
+			seen = generation_;
+			const auto job     = job_;
+			const auto context = context_;
+			lock.unlock();
+			job(context, self);
+			lock.lock();
+			if (--busy_ == 0) { done_.notify_one(); }
+		}
+	}
+	std::mutex job_mutex_;
+	std::mutex mutex_;
+	std::condition_variable wake_;
+	std::condition_variable done_;
+	void (*job_)(void*, size_t) = nullptr;
+	void* context_              = nullptr;
+	size_t generation_          = 0;
+	size_t busy_                = 0;
+	bool stop_                  = false;
+	std::vector<std::jthread> workers_;
+};
+
+namespace detail {
+
+// Cuts [0, count) into chunks dealt out to a queue per thread, then calls
+// launch(work), which must call work(t) once for each t in [0, threads).
+// Threads work from the back of their own queue and steal from the front
+// of the others' once it is empty, so one slow item doesn't hold
+// everything else up.
+template <class Fn, class Launch>
+auto work_stealing(size_t count, size_t threads, Fn&& fn, Launch&& launch) -> void {
+	struct queue {
+		std::mutex mutex;
+		std::deque<size_t> chunks;
+	};
+	const auto chunk_size = std::max(count / (threads * 8), size_t(1));
+	const auto chunks     = (count + chunk_size - 1) / chunk_size;
+	auto queues = std::vector<std::unique_ptr<queue>>(threads);
+	for (auto& q : queues) { q = std::make_unique<queue>(); }
+	for (size_t c = 0; c < chunks; c++) {
+		queues[c % threads]->chunks.push_back(c);
+	}
+	const auto pop = [&queues](size_t self) -> std::optional<size_t> {
+		{
+			auto& own = *queues[self];
+			auto lock = std::lock_guard{own.mutex};
+			if (!own.chunks.empty()) {
+				const auto c = own.chunks.back();
+				own.chunks.pop_back();
+				return c;
+			}
+		}
+		for (size_t k = 1; k < queues.size(); k++) {
+			auto& other = *queues[(self + k) % queues.size()];
+			auto lock   = std::lock_guard{other.mutex};
+			if (!other.chunks.empty()) {
+				const auto c = other.chunks.front();
+				other.chunks.pop_front();
+				return c;
+			}
+		}
+		return std::nullopt;
+	};
+	const auto work = [&](size_t self) {
+		while (const auto c = pop(self)) {
+			const auto end = std::min((*c + 1) * chunk_size, count);
+			for (auto i = *c * chunk_size; i < end; i++) { fn(i); }
+		}
+	};
+	launch(work);
+}
+
+} // detail
+
+// Calls fn(i) for every i in [0, count) across up to `threads` threads
+// (0 for one per core) and returns when all are done. Starts its threads
+// on every call, so prefer the thread_pool overload for repeated work.
+template <class Fn>
+auto parallel_for(size_t count, size_t threads, Fn&& fn) -> void {
+	if (count == 0) { return; }
+	threads = std::min(detail::thread_count(threads), count);
+	if (threads == 1) {
+		for (size_t i = 0; i < count; i++) { fn(i); }
+		return;
+	}
+	detail::work_stealing(count, threads, fn, [threads](const auto& work) {
+		auto workers = std::vector<std::jthread>{};
+		workers.reserve(threads - 1);
+		for (size_t t = 1; t < threads; t++) {
+			workers.emplace_back(work, t);
+		}
+		work(0);
+	});
+}
+
+// The same on the pool's threads
+template <class Fn>
+auto parallel_for(thread_pool& pool, size_t count, Fn&& fn) -> void {
+	if (count == 0) { return; }
+	const auto threads = std::min(pool.size(), count);
+	if (threads == 1) {
+		for (size_t i = 0; i < count; i++) { fn(i); }
+		return;
+	}
+	detail::work_stealing(count, threads, fn, [&pool, threads](const auto& work) {
+		pool.run([&work, threads](size_t t) { if (t < threads) { work(t); } });
+	});
+}
+
+} // tweak
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <charconv>
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+
+namespace tweak::parse {
+
+template <class T>
+struct number {
+	T value;
+	size_t begin;
+	size_t end;
+};
+
+[[nodiscard]] constexpr
+auto is_digit(char c) -> bool {
+	return c >= '0' && c <= '9';
+}
+
+[[nodiscard]] constexpr
+auto is_alpha(char c) -> bool {
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+[[nodiscard]] constexpr
+auto to_lower(char c) -> char {
+	return c >= 'A' && c <= 'Z' ? char(c - 'A' + 'a') : c;
+}
+
+// Case insensitive comparison against an already lowercase string
+[[nodiscard]] constexpr
+auto iequals(std::string_view str, std::string_view lower) -> bool {
+	if (str.size() != lower.size()) { return false; }
+	for (size_t i = 0; i < str.size(); i++) {
+		if (to_lower(str[i]) != lower[i]) { return false; }
+	}
+	return true;
+}
+
+[[nodiscard]] constexpr
+auto starts_number(std::string_view str, size_t pos) -> bool {
+	if (pos >= str.size())   { return false; }
+	if (is_digit(str[pos]))  { return true; }
+	return str[pos] == '.' && pos + 1 < str.size() && is_digit(str[pos + 1]);
+}
+
+[[nodiscard]] constexpr
+auto skip_spaces(std::string_view str, size_t pos) -> size_t {
+	while (pos < str.size() && (str[pos] == ' ' || str[pos] == '\t')) { pos++; }
+	return pos;
+}
+
+// Parse the unsigned number starting at str[pos]. The sign, if any, is
+// left to the caller.
+template <std::floating_point T> [[nodiscard]]
+auto number_at(std::string_view str, size_t pos) -> std::optional<number<T>> {
+	if (!starts_number(str, pos)) { return std::nullopt; }
+	auto end = pos;
+	while (end < str.size() && (is_digit(str[end]) || str[end] == '.')) { end++; }
+	auto value        = T(0);
+	const auto result = std::from_chars(str.data() + pos, str.data() + end, value, std::chars_format::fixed);
+	if (result.ec != std::errc{}) { return std::nullopt; }
+	return number<T>{value, pos, static_cast<size_t>(result.ptr - str.data())};
+}
+
+template <std::integral T> [[nodiscard]]
+auto number_at(std::string_view str, size_t pos) -> std::optional<number<T>> {
+	if (pos >= str.size() || !is_digit(str[pos])) { return std::nullopt; }
+	auto value        = T(0);
+	const auto result = std::from_chars(str.data() + pos, str.data() + str.size(), value);
+	if (result.ec != std::errc{}) { return std::nullopt; }
+	return number<T>{value, pos, static_cast<size_t>(result.ptr - str.data())};
+}
+
+// Find the leftmost number in the string. When allow_negative is set a
+// '-' before it, optionally followed by spaces, negates it.
+template <class T> [[nodiscard]]
+auto find_number(std::string_view str, bool allow_negative) -> std::optional<number<T>> {
+	for (size_t pos = 0; pos < str.size(); pos++) {
+		const auto start = std::floating_point<T> ? starts_number(str, pos) : is_digit(str[pos]);
+		if (!start) { continue; }
+		auto result = number_at<T>(str, pos);
+		if (!result) { return std::nullopt; }
+		if (!allow_negative) { return result; }
+		auto sign = pos;
+		while (sign > 0 && (str[sign - 1] == ' ' || str[sign - 1] == '\t')) { sign--; }
+		if (sign > 0 && str[sign - 1] == '-') {
+			result->value = -result->value;
+			result->begin = sign - 1;
+		}
+		return result;
+	}
+	return std::nullopt;
+}
+
+} // tweak::parse
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <optional>
+#include <span>
+#include <string_view>
+#include "format.hpp"
+
+namespace tweak {
+
+// The domain a policy steps and interpolates in
+enum class domain { linear, log, db };
+
+// Steps per unit of the policy's domain, normally and when precise
+struct steps {
+	int normal;
+	int precise;
+};
+
+// A parameter policy is a type with static members describing one kind of
+// value: its range, default, step sizes and domain, plus the functions to
+// constrain and step it and to map it to and from [0, 1].
+template <class P>
+concept policy = requires (typename P::value_type v, bool precise, int amount) {
+	requires std::floating_point<typename P::value_type>;
+	{ P::MIN } -> std::convertible_to<typename P::value_type>;
+	{ P::MAX } -> std::convertible_to<typename P::value_type>;
+	{ P::DEFAULT } -> std::convertible_to<typename P::value_type>;
+	{ P::DOMAIN } -> std::convertible_to<domain>;
+	{ P::STEPS } -> std::convertible_to<steps>;
+	{ P::constrain(v) } -> std::same_as<typename P::value_type>;
+	{ P::stepify(v) } -> std::same_as<typename P::value_type>;
+	{ P::increment(v, precise) } -> std::same_as<typename P::value_type>;
+	{ P::decrement(v, precise) } -> std::same_as<typename P::value_type>;
+	{ P::drag(v, amount, precise) } -> std::same_as<typename P::value_type>;
+	{ P::to_normalized(v) } -> std::same_as<typename P::value_type>;
+	{ P::from_normalized(v) } -> std::same_as<typename P::value_type>;
+};
+
+template <class P>
+concept formattable_policy = policy<P> && requires (typename P::value_type v, std::string_view str) {
+	{ P::to_label(v) } -> std::same_as<label>;
+	{ P::from_string(str) } -> std::same_as<std::optional<typename P::value_type>>;
+};
+
+} // tweak
+
+// Generic algorithms over a policy. Everything is resolved at compile time
+// so each loop is the policy's own code inlined.
+namespace tweak::batch {
+
+template <policy P>
+auto constrain(std::span<const typename P::value_type> in, std::span<typename P::value_type> out) -> void {
+	const auto n = std::min(in.size(), out.size());
+	for (size_t i = 0; i < n; i++) {
+		out[i] = P::constrain(in[i]);
+	}
+}
+
+template <policy P>
+auto stepify(std::span<const typename P::value_type> in, std::span<typename P::value_type> out) -> void {
+	const auto n = std::min(in.size(), out.size());
+	for (size_t i = 0; i < n; i++) {
+		out[i] = P::stepify(in[i]);
+	}
+}
+
+template <policy P>
+auto increment(std::span<const typename P::value_type> in, bool precise, std::span<typename P::value_type> out) -> void {
+	const auto n = std::min(in.size(), out.size());
+	for (size_t i = 0; i < n; i++) {
+		out[i] = P::increment(in[i], precise);
+	}
+}
+
+template <policy P>
+auto decrement(std::span<const typename P::value_type> in, bool precise, std::span<typename P::value_type> out) -> void {
+	const auto n = std::min(in.size(), out.size());
+	for (size_t i = 0; i < n; i++) {
+		out[i] = P::decrement(in[i], precise);
+	}
+}
+
+template <policy P>
+auto drag(std::span<const typename P::value_type> in, int amount, bool precise, std::span<typename P::value_type> out) -> void {
+	const auto n = std::min(in.size(), out.size());
+	for (size_t i = 0; i < n; i++) {
+		out[i] = P::drag(in[i], amount, precise);
+	}
+}
+
+template <policy P>
+auto to_normalized(std::span<const typename P::value_type> in, std::span<typename P::value_type> out) -> void {
+	const auto n = std::min(in.size(), out.size());
+	for (size_t i = 0; i < n; i++) {
+		out[i] = P::to_normalized(in[i]);
+	}
+}
+
+template <policy P>
+auto from_normalized(std::span<const typename P::value_type> in, std::span<typename P::value_type> out) -> void {
+	const auto n = std::min(in.size(), out.size());
+	for (size_t i = 0; i < n; i++) {
+		out[i] = P::from_normalized(in[i]);
+	}
+}
+
+template <formattable_policy P>
+auto to_label(std::span<const typename P::value_type> in, std::span<label> out) -> void {
+	const auto n = std::min(in.size(), out.size());
+	for (size_t i = 0; i < n; i++) {
+		out[i] = P::to_label(in[i]);
+	}
+}
+
+} // tweak::batch
@@ -0,0 +1,274 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "any-param.hpp"
+
+// Binary preset banks. Everything is little endian:
+//
+//   header     "TWKB", u16 version, u16 flags, u32 preset count, u32 zero
+//   directory  per preset: u32 entries offset, u32 entry count,
+//              u32 name offset, u32 name size
+//   entries    per preset, sorted by id:
+//                quantized  u32 id, u8 kind, u8 zero, u16 normalized value
+//                otherwise  u32 id, u8 kind, u8 zero, u16 zero, f32 value
+//   names      UTF-8, not terminated
+//
+// Quantized values are the policy's normalized value scaled to 16 bits,
+// and are stepified when decoded.
+namespace tweak::preset {
+
+inline constexpr auto MAGIC          = std::string_view{"TWKB"};
+inline constexpr auto VERSION        = std::uint16_t(1);
+inline constexpr auto QUANTIZED      = std::uint16_t(1);
+inline constexpr auto HEADER_SIZE    = size_t(16);
+inline constexpr auto DIRECTORY_SIZE = size_t(16);
+inline constexpr auto QUANTIZED_SIZE = size_t(8);
+inline constexpr auto FULL_SIZE      = size_t(12);
+inline constexpr auto QUANTIZED_MAX  = 65535.0f;
+
+struct entry {
+	std::uint32_t id;
+	param_kind kind;
+	float value;
+};
+
+namespace detail {
+
+[[nodiscard]] inline
+auto load_u16(const std::byte* p) -> std::uint16_t {
+	return std::uint16_t(std::uint16_t(p[0]) | std::uint16_t(p[1]) << 8);
+}
+
+[[nodiscard]] inline
+auto load_u32(const std::byte* p) -> std::uint32_t {
+	return std::uint32_t(p[0]) | std::uint32_t(p[1]) << 8 | std::uint32_t(p[2]) << 16 | std::uint32_t(p[3]) << 24;
+}
+
+[[nodiscard]] inline
+auto load_f32(const std::byte* p) -> float {
+	const auto bits = load_u32(p);
+	auto out = 0.0f;
+	std::memcpy(&out, &bits, sizeof(out));
+	return out;
+}
+
+inline auto store_u16(std::vector<std::byte>* out, std::uint16_t v) -> void {
+	out->push_back(std::byte(v & 0xFF));
+	out->push_back(std::byte(v >> 8));
+}
+
+inline auto store_u32(std::vector<std::byte>* out, std::uint32_t v) -> void {
+	for (auto shift = 0; shift < 32; shift += 8) {
+		out->push_back(std::byte((v >> shift) & 0xFF));
+	}
+}
+
+inline auto store_f32(std::vector<std::byte>* out, float v) -> void {
+	auto bits = std::uint32_t{};
+	std::memcpy(&bits, &v, sizeof(bits));
+	store_u32(out, bits);
+}
+
+// Kinds a handle could be created with in this process
+[[nodiscard]] inline
+auto is_known(param_kind k) -> bool {
+	return size_t(k) < BUILTIN_KINDS + tweak::detail::user_policy_count;
+}
+
+} // detail
+
+[[nodiscard]] inline
+auto quantize(param_kind kind, float value) -> std::uint16_t {
+	const auto n = visit(kind, [value](const auto& p) { return p.to_normalized(p.constrain(value)); });
+	return static_cast<std::uint16_t>(std::lround(std::clamp(n, 0.0f, 1.0f) * QUANTIZED_MAX));
+}
+
+[[nodiscard]] inline
+auto dequantize(param_kind kind, std::uint16_t q) -> float {
+	const auto n = float(q) / QUANTIZED_MAX;
+	return visit(kind, [n](const auto& p) { return p.stepify(p.from_normalized(n)); });
+}
+
+// One preset in a bank. Entries are decoded when they are accessed.
+struct preset_view {
+	preset_view(std::string_view name, std::span<const std::byte> entries, bool quantized)
+		: name_{name}, entries_{entries}, entry_size_{quantized ? QUANTIZED_SIZE : FULL_SIZE} {}
+	[[nodiscard]] auto name() const -> std::string_view { return name_; }
+	[[nodiscard]] auto size() const -> size_t { return entries_.size() / entry_size_; }
+	[[nodiscard]] auto id(size_t i) const -> std::uint32_t { return detail::load_u32(entries_.data() + i * entry_size_); }
+	// Quantized entries of kinds unknown to this process decode to their
+	// normalized value.
+	[[nodiscard]] auto operator[](size_t i) const -> entry {
+		const auto p    = entries_.data() + i * entry_size_;
+		const auto kind = param_kind(std::to_integer<std::uint8_t>(p[4]));
+		if (entry_size_ == FULL_SIZE)    { return {detail::load_u32(p), kind, detail::load_f32(p + 8)}; }
+		if (!detail::is_known(kind))     { return {detail::load_u32(p), kind, float(detail::load_u16(p + 6)) / QUANTIZED_MAX}; }
+		return {detail::load_u32(p), kind, dequantize(kind, detail::load_u16(p + 6))};
+	}
+	[[nodiscard]] auto find(std::uint32_t id) const -> std::optional<entry> {
+		auto lo = size_t(0);
+		auto hi = size();
+		while (lo < hi) {
+			const auto mid = lo + (hi - lo) / 2;
+			if (this->id(mid) < id) { lo = mid + 1; }
+			else                    { hi = mid; }
+		}
+		if (lo < size() && this->id(lo) == id) { return (*this)[lo]; }
+		return std::nullopt;
+	}
+private:
+	std::string_view name_;
+	std::span<const std::byte> entries_;
+	size_t entry_size_;
+};
+
+// A bank over bytes owned by the caller, typically a mapped_file. Opening
+// only checks the header and directory; presets are decoded on access.
+struct bank_view {
+	[[nodiscard]] static auto open(std::span<const std::byte> bytes) -> std::optional<bank_view> {
+		if (bytes.size() < HEADER_SIZE) { return std::nullopt; }
+		if (std::memcmp(bytes.data(), MAGIC.data(), MAGIC.size()) != 0) { return std::nullopt; }
+		if (detail::load_u16(bytes.data() + 4) != VERSION) { return std::nullopt; }
+		const auto quantized  = (detail::load_u16(bytes.data() + 6) & QUANTIZED) != 0;
+		const auto count      = size_t(detail::load_u32(bytes.data() + 8));
+		const auto entry_size = quantized ? QUANTIZED_SIZE : FULL_SIZE;
+		if (count > (bytes.size() - HEADER_SIZE) / DIRECTORY_SIZE) { return std::nullopt; }
+		for (size_t i = 0; i < count; i++) {
+			const auto dir     = bytes.data() + HEADER_SIZE + i * DIRECTORY_SIZE;
+			const auto offset  = size_t(detail::load_u32(dir));
+			const auto entries = size_t(detail::load_u32(dir + 4));
+			const auto name    = size_t(detail::load_u32(dir + 8));
+			const auto length  = size_t(detail::load_u32(dir + 12));
+			if (offset > bytes.size() || entries > (bytes.size() - offset) / entry_size) { return std::nullopt; }
+			if (name > bytes.size() || length > bytes.size() - name)                     { return std::nullopt; }
+		}
+		return bank_view{bytes, count, quantized};
+	}
+	[[nodiscard]] auto size() const -> size_t { return count_; }
+	[[nodiscard]] auto quantized() const -> bool { return quantized_; }
+	[[nodiscard]] auto name(size_t i) const -> std::string_view {
+		const auto dir = directory(i);
+		return {reinterpret_cast<const char*>(bytes_.data()) + detail::load_u32(dir + 8), detail::load_u32(dir + 12)};
+	}
+	[[nodiscard]] auto operator[](size_t i) const -> preset_view {
+		const auto dir        = directory(i);
+		const auto entry_size = quantized_ ? QUANTIZED_SIZE : FULL_SIZE;
+		return {name(i), bytes_.subspan(detail::load_u32(dir), detail::load_u32(dir + 4) * entry_size), quantized_};
+	}
+private:
+	bank_view(std::span<const std::byte> bytes, size_t count, bool quantized) : bytes_{bytes}, count_{count}, quantized_{quantized} {}
+	[[nodiscard]] auto directory(size_t i) const -> const std::byte* { return bytes_.data() + HEADER_SIZE + i * DIRECTORY_SIZE; }
+	std::span<const std::byte> bytes_;
+	size_t count_;
+	bool quantized_;
+};
+
+// Builds a bank. Values can be given as text, parsed with the policy's
+// from_string, which converts presets stored in the text format.
+struct bank_writer {
+	bank_writer(bool quantized = false) : quantized_{quantized} {}
+	auto begin_preset(std::string_view name) -> void {
+		presets_.push_back({std::string{name}, {}});
+	}
+	// Adds to the last preset. A repeated id replaces the earlier value.
+	// Returns false, adding nothing, if kind isn't a built in or registered
+	// kind.
+	auto add(std::uint32_t id, param_kind kind, float value) -> bool {
+		if (!detail::is_known(kind)) { return false; }
+		if (presets_.empty()) { begin_preset({}); }
+		presets_.back().entries.push_back({id, kind, value});
+		return true;
+	}
+	// Returns false, adding nothing, if the text doesn't parse or kind is
+	// unknown
+	auto add(std::uint32_t id, param_kind kind, std::string_view text) -> bool {
+		if (!detail::is_known(kind)) { return false; }
+		const auto value = visit(kind, [text](const auto& p) { return p.from_string(text); });
+		if (!value) { return false; }
+		add(id, kind, *value);
+		return true;
+	}
+	// Empty if an offset or size doesn't fit the format's 32 bits, which
+	// happens once the bank passes 4 GiB
+	[[nodiscard]] auto bytes() const -> std::vector<std::byte> {
+		if (presets_.size() > UINT32_MAX) { return {}; }
+		auto out = std::vector<std::byte>{};
+		out.reserve(HEADER_SIZE + presets_.size() * DIRECTORY_SIZE);
+		for (const auto c : MAGIC) { out.push_back(std::byte(c)); }
+		detail::store_u16(&out, VERSION);
+		detail::store_u16(&out, quantized_ ? QUANTIZED : 0);
+		detail::store_u32(&out, static_cast<std::uint32_t>(presets_.size()));
+		detail::store_u32(&out, 0);
+		// The directory is filled in once the offsets are known
+		out.resize(HEADER_SIZE + presets_.size() * DIRECTORY_SIZE);
+		auto sorted = std::vector<entry>{};
+		for (size_t i = 0; i < presets_.size(); i++) {
+			sorted.assign(presets_[i].entries.begin(), presets_[i].entries.end());
+			std::stable_sort(sorted.begin(), sorted.end(), [](const entry& a, const entry& b) { return a.id < b.id; });
+			// Keep the last of each run of equal ids
+			auto end = sorted.begin();
+			for (auto it = sorted.begin(); it != sorted.end(); it++) {
+				if (std::next(it) != sorted.end() && std::next(it)->id == it->id) { continue; }
+				*end++ = *it;
+			}
+			sorted.erase(end, sorted.end());
+			const auto dir = HEADER_SIZE + i * DIRECTORY_SIZE;
+			if (!set_u32(&out, dir, out.size()) || !set_u32(&out, dir + 4, sorted.size())) { return {}; }
+			for (const auto& e : sorted) {
+				detail::store_u32(&out, e.id);
+				out.push_back(std::byte(std::uint8_t(e.kind)));
+				out.push_back(std::byte{0});
+				if (quantized_) {
+					detail::store_u16(&out, quantize(e.kind, e.value));
+				}
+				else {
+					detail::store_u16(&out, 0);
+					detail::store_f32(&out, e.value);
+				}
+			}
+		}
+		for (size_t i = 0; i < presets_.size(); i++) {
+			const auto& name = presets_[i].name;
+			const auto dir   = HEADER_SIZE + i * DIRECTORY_SIZE;
+			if (!set_u32(&out, dir + 8, out.size()) || !set_u32(&out, dir + 12, name.size())) { return {}; }
+			for (const auto c : name) { out.push_back(std::byte(c)); }
+		}
+		return out;
+	}
+	// Returns false, writing nothing, if the bank is too big for the format
+	auto write(const std::filesystem::path& path) const -> bool {
+		const auto data = bytes();
+		if (data.empty()) { return false; }
+		auto file = std::fopen(path.string().c_str(), "wb");
+		if (!file) { return false; }
+		const auto written = std::fwrite(data.data(), 1, data.size(), file);
+		return std::fclose(file) == 0 && written == data.size();
+	}
+private:
+	struct preset {
+		std::string name;
+		std::vector<entry> entries;
+	};
+	// Returns false if v doesn't fit
+	static auto set_u32(std::vector<std::byte>* out, size_t pos, size_t v) -> bool {
+		if (v > UINT32_MAX) { return false; }
+		for (auto shift = 0; shift < 32; shift += 8) {
+			(*out)[pos++] = std::byte((v >> shift) & 0xFF);
+		}
+		return true;
+	}
+	bool quantized_;
+	std::vector<preset> presets_;
+};
+
+} // tweak::preset
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include "any-param.hpp"
+#include "parallel.hpp"
+#include "preset-text.hpp"
+
+namespace tweak::preset {
+
+// A parameter the library indexes, by its key in the text presets
+struct field {
+	std::string key;
+	param_kind kind;
+};
+
+struct scan_stats {
+	size_t parsed  = 0; // New or modified files
+	size_t reused  = 0; // Unchanged since the last scan
+	size_t removed = 0; // Gone since the last scan
+	size_t failed  = 0; // Couldn't be opened
+};
+
+// An index of a directory of text presets. Each field is a column of
+// stepified values with one row per preset, NaN where a preset doesn't
+// set the field, so queries are a scan over one contiguous array.
+struct library {
+	library(std::vector<field> fields) : fields_{std::move(fields)} {
+		for (size_t i = 0; i < fields_.size(); i++) {
+			keys_.push_back({fields_[i].key, i});
+		}
+		std::sort(keys_.begin(), keys_.end());
+	}
+	[[nodiscard]] auto size() const -> size_t { return paths_.size(); }
+	[[nodiscard]] auto fields() const -> std::span<const field> { return fields_; }
+	[[nodiscard]] auto path(size_t row) const -> const std::filesystem::path& { return paths_[row]; }
+	[[nodiscard]] auto column(size_t f) const -> std::span<const float> { return std::span{values_}.subspan(f * size(), size()); }
+	[[nodiscard]] auto value(size_t row, size_t f) const -> float { return values_[f * size() + row]; }
+	[[nodiscard]] auto find_field(std::string_view key) const -> std::optional<size_t> {
+		const auto pos = std::lower_bound(keys_.begin(), keys_.end(), key, [](const auto& k, std::string_view key) { return k.first < key; });
+		if (pos == keys_.end() || pos->first != key) { return std::nullopt; }
+		return pos->second;
+	}
+	// Indexes every file with the given extension under dir. Files already
+	// indexed whose modification time hasn't changed aren't read again. The
+	// threads are kept for the next scan, unless it asks for a different
+	// number.
+	auto scan(const std::filesystem::path& dir, std::string_view extension = ".tweak", size_t threads = 0) -> scan_stats {
+		auto stats  = scan_stats{};
+		auto found  = std::vector<std::filesystem::path>{};
+		auto mtimes = std::vector<std::int64_t>{};
+		auto ec     = std::error_code{};
+		for (auto it = std::filesystem::recursive_directory_iterator{dir, ec}; !ec && it != std::filesystem::recursive_directory_iterator{}; it.increment(ec)) {
+			if (!it->is_regular_file(ec) || it->path().extension() != extension) { continue; }
+			found.push_back(it->path());
+		}
+		std::sort(found.begin(), found.end());
+		mtimes.resize(found.size());
+		for (size_t i = 0; i < found.size(); i++) {
+			const auto time = std::filesystem::last_write_time(found[i], ec);
+			mtimes[i] = ec ? 0 : static_cast<std::int64_t>(time.time_since_epoch().count());
+		}
+		const auto rows = found.size();
+		auto values     = std::vector<float>(fields_.size() * rows, std::numeric_limits<float>::quiet_NaN());
+		auto stale      = std::vector<std::uint32_t>{};
+		auto old        = size_t(0);
+		// Both lists are sorted so matching old rows is a merge
+		for (size_t row = 0; row < rows; row++) {
+			while (old < paths_.size() && paths_[old] < found[row]) { old++; stats.removed++; }
+			if (old < paths_.size() && paths_[old] == found[row] && mtimes_[old] == mtimes[row] && mtimes[row] != 0) {
+				for (size_t f = 0; f < fields_.size(); f++) {
+					values[f * rows + row] = value(old, f);
+				}
+				stats.reused++;
+			}
+			else {
+				stale.push_back(static_cast<std::uint32_t>(row));
+			}
+			if (old < paths_.size() && paths_[old] == found[row]) { old++; }
+		}
+		stats.removed += paths_.size() - old;
+		auto failed = std::vector<std::uint8_t>(stale.size());
+		if (!pool_ || pool_->size() != tweak::detail::thread_count(threads)) { pool_ = std::make_shared<thread_pool>(threads); }
+		parallel_for(*pool_, stale.size(), [&](size_t i) {
+			const auto row = stale[i];
+			if (!parse_file(found[row], rows, row, std::span{values})) { failed[i] = 1; }
+		});
+		stats.parsed = stale.size();
+		for (size_t i = 0; i < stale.size(); i++) {
+			if (!failed[i]) { continue; }
+			// Read it again next time even if it isn't modified, e.g. once its
+			// permissions are fixed
+			mtimes[stale[i]] = 0;
+			stats.failed++;
+		}
+		paths_  = std::move(found);
+		mtimes_ = std::move(mtimes);
+		values_ = std::move(values);
+		return stats;
+	}
+	// Rows whose value of field f is within [min, max]. NaN (unset) never
+	// matches. Pass the result back in as `rows` to narrow it by another
+	// field.
+	[[nodiscard]] auto select(size_t f, float min, float max) const -> std::vector<std::uint32_t> {
+		auto out          = std::vector<std::uint32_t>{};
+		const auto values = column(f);
+		for (size_t row = 0; row < values.size(); row++) {
+			if (values[row] >= min && values[row] <= max) { out.push_back(static_cast<std::uint32_t>(row)); }
+		}
+		return out;
+	}
+	[[nodiscard]] auto select(size_t f, float min, float max, std::span<const std::uint32_t> rows) const -> std::vector<std::uint32_t> {
+		auto out          = std::vector<std::uint32_t>{};
+		const auto values = column(f);
+		for (const auto row : rows) {
+			if (values[row] >= min && values[row] <= max) { out.push_back(row); }
+		}
+		return out;
+	}
+	// Rows whose value of field f has the same stepified value as v
+	[[nodiscard]] auto select_equal(size_t f, float v) const -> std::vector<std::uint32_t> {
+		const auto stepified = visit(fields_[f].kind, [v](const auto& p) { return p.stepify(p.constrain(v)); });
+		return select(f, stepified, stepified);
+	}
+private:
+	auto parse_file(const std::filesystem::path& path, size_t rows, size_t row, std::span<float> values) const -> bool {
+		const auto file = std::fopen(path.string().c_str(), "rb");
+		if (!file) { return false; }
+		auto buffer = std::array<char, 4096>{};
+		auto reader = text_reader{std::span{buffer}, [file](std::span<char> out) { return std::fread(out.data(), 1, out.size(), file); }};
+		while (const auto line = reader.next()) {
+			const auto f = find_field(line->key);
+			if (!f) { continue; }
+			if (const auto v = parse_value(fields_[*f].kind, line->value)) {
+				values[*f * rows + row] = *v;
+			}
+		}
+		std::fclose(file);
+		return true;
+	}
+	std::vector<field> fields_;
+	std::vector<std::pair<std::string, size_t>> keys_;
+	std::vector<std::filesystem::path> paths_;
+	std::vector<std::int64_t> mtimes_;
+	std::vector<float> values_;
+	std::shared_ptr<thread_pool> pool_;
+};
+
+} // tweak::preset
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "any-param.hpp"
+#include "format.hpp"
+
+#if defined(_WIN32)
+#	include <io.h>
+#else
+#	include <unistd.h>
+#endif
+
+// Streaming key=value text presets, one parameter per line:
+//
+//   # comment
+//   cutoff=440
+//   gain=0.501187
+//
+// Values are written as the exact stepified value in the policy's units,
+// so reading a file back gives the same stepified values. The reader also
+// takes anything the policy's from_string accepts, e.g. "1.2 kHz".
+//
+// Both ends work a line at a time through a buffer supplied by the caller,
+// so memory use doesn't depend on the size of the file.
+namespace tweak::preset {
+
+struct line {
+	std::string_view key;
+	std::string_view value;
+};
+
+// Sources fill the span they are given and return how much they wrote,
+// or 0 at the end. Sinks return false if they couldn't take everything.
+
+struct memory_source {
+	std::string_view text;
+	auto operator()(std::span<char> out) -> size_t {
+		const auto n = std::min(out.size(), text.size());
+		std::memcpy(out.data(), text.data(), n);
+		text.remove_prefix(n);
+		return n;
+	}
+};
+
+struct fd_source {
+	int fd;
+	auto operator()(std::span<char> out) -> size_t {
+#if defined(_WIN32)
+		const auto n = ::_read(fd, out.data(), static_cast<unsigned>(std::min(out.size(), size_t(1) << 30)));
+#else
+		const auto n = ::read(fd, out.data(), out.size());
+#endif
+		return n > 0 ? static_cast<size_t>(n) : 0;
+	}
+};
+
+struct fd_sink {
+	int fd;
+	auto operator()(std::string_view s) -> bool {
+		while (!s.empty()) {
+#if defined(_WIN32)
+			const auto n = ::_write(fd, s.data(), static_cast<unsigned>(std::min(s.size(), size_t(1) << 30)));
+#else
+			const auto n = ::write(fd, s.data(), s.size());
+#endif
+			if (n <= 0) { return false; }
+			s.remove_prefix(static_cast<size_t>(n));
+		}
+		return true;
+	}
+};
+
+struct string_sink {
+	std::string* out;
+	auto operator()(std::string_view s) -> bool {
+		out->append(s);
+		return true;
+	}
+};
+
+namespace detail {
+
+[[nodiscard]] inline
+auto trim(std::string_view s) -> std::string_view {
+	const auto space = [](char c) { return c == ' ' || c == '\t' || c == '\r'; };
+	while (!s.empty() && space(s.front())) { s.remove_prefix(1); }
+	while (!s.empty() && space(s.back()))  { s.remove_suffix(1); }
+	return s;
+}
+
+} // detail
+
+[[nodiscard]] inline
+auto format_value(param_kind kind, float value) -> label {
+	const auto v = visit(kind, [value](const auto& p) { return p.stepify(p.constrain(value)); });
+	return label{}.append_exact(v);
+}
+
+[[nodiscard]] inline
+auto parse_value(param_kind kind, std::string_view str) -> std::optional<float> {
+	auto value     = 0.0f;
+	const auto end = str.data() + str.size();
+	auto parsed    = std::optional<float>{};
+	if (const auto result = std::from_chars(str.data(), end, value); result.ec == std::errc{} && result.ptr == end) {
+		parsed = value;
+	}
+	else {
+		parsed = visit(kind, [str](const auto& p) { return p.from_string(str); });
+	}
+	if (!parsed) { return std::nullopt; }
+	return visit(kind, [v = *parsed](const auto& p) { return p.stepify(p.constrain(v)); });
+}
+
+template <class Source>
+struct text_reader {
+	text_reader(std::span<char> buffer, Source source) : buffer_{buffer}, source_{std::move(source)} {}
+	// The next key=value pair. Blank lines and lines starting with '#' are
+	// skipped, and so are lines without a '=' or longer than the buffer,
+	// which are counted by skipped(). The views point into the buffer so are
+	// only valid until the next call.
+	[[nodiscard]] auto next() -> std::optional<line> {
+		while (const auto raw = next_line()) {
+			const auto text = detail::trim(*raw);
+			if (text.empty() || text.front() == '#') { continue; }
+			const auto eq = text.find('=');
+			if (eq == std::string_view::npos) {
+				skipped_++;
+				continue;
+			}
+			return line{detail::trim(text.substr(0, eq)), detail::trim(text.substr(eq + 1))};
+		}
+		return std::nullopt;
+	}
+	[[nodiscard]] auto skipped() const -> size_t { return skipped_; }
+private:
+	auto next_line() -> std::optional<std::string_view> {
+		for (;;) {
+			const auto pending = std::string_view{buffer_.data() + begin_, end_ - begin_};
+			const auto newline = pending.find('\n');
+			if (newline != std::string_view::npos || (eof_ && !pending.empty())) {
+				const auto length = newline != std::string_view::npos ? newline : pending.size();
+				begin_ += newline != std::string_view::npos ? length + 1 : length;
+				if (discarding_) {
+					discarding_ = false;
+					skipped_++;
+					continue;
+				}
+				return pending.substr(0, length);
+			}
+			if (eof_) {
+				// An overlong last line with no newline after it
+				if (discarding_) {
+					discarding_ = false;
+					skipped_++;
+				}
+				return std::nullopt;
+			}
+			if (begin_ == 0 && end_ == buffer_.size()) {
+				// The line doesn't fit so drop it up to the next newline
+				discarding_ = true;
+				end_        = 0;
+			}
+			else {
+				std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+				end_ -= begin_;
+			}
+			begin_ = 0;
+			const auto n = source_(buffer_.subspan(end_));
+			if (n == 0) { eof_ = true; }
+			end_ += n;
+		}
+	}
+	std::span<char> buffer_;
+	Source source_;
+	size_t begin_    = 0;
+	size_t end_      = 0;
+	size_t skipped_  = 0;
+	bool eof_        = false;
+	bool discarding_ = false;
+};
+
+// Keys must not contain '=' or newlines
+template <class Sink>
+struct text_writer {
+	text_writer(std::span<char> buffer, Sink sink) : buffer_{buffer}, sink_{std::move(sink)} {}
+	text_writer(const text_writer&) = delete;
+	auto operator=(const text_writer&) -> text_writer& = delete;
+	~text_writer() { flush(); }
+	auto write(std::string_view key, std::string_view value) -> bool {
+		const auto length = key.size() + value.size() + 2;
+		if (size_ + length > buffer_.size() && !flush()) { return false; }
+		if (length > buffer_.size()) {
+			return sink_(key) && sink_("=") && sink_(value) && sink_("\n");
+		}
+		append(key);
+		append("=");
+		append(value);
+		append("\n");
+		return true;
+	}
+	auto write(std::string_view key, param_kind kind, float value) -> bool {
+		return write(key, format_value(kind, value).view());
+	}
+	auto write(std::string_view key, const any_param& param) -> bool {
+		return write(key, param.kind(), param.value());
+	}
+	auto flush() -> bool {
+		if (size_ == 0) { return true; }
+		const auto ok = sink_({buffer_.data(), size_});
+		size_ = 0;
+		return ok;
+	}
+private:
+	auto append(std::string_view s) -> void {
+		std::memcpy(buffer_.data() + size_, s.data(), s.size());
+		size_ += s.size();
+	}
+	std::span<char> buffer_;
+	Sink sink_;
+	size_t size_ = 0;
+};
+
+} // tweak::preset
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include "any-param.hpp"
+#include "policy.hpp"
+
+// Randomizing and mutating parameters.
+//
+// Random numbers come from a counter based generator: the n-th number is a
+// hash of the seed and n, so the numbers are reproducible from the seed,
+// the value for each parameter doesn't depend on the others or on which
+// are locked, and each loop is free of dependencies between iterations.
+namespace tweak::random {
+
+inline constexpr auto GOLDEN_GAMMA = std::uint64_t(0x9E3779B97F4A7C15);
+
+// SplitMix64 finalizer
+[[nodiscard]] constexpr
+auto mix(std::uint64_t x) -> std::uint64_t {
+	x = (x ^ (x >> 30)) * std::uint64_t(0xBF58476D1CE4E5B9);
+	x = (x ^ (x >> 27)) * std::uint64_t(0x94D049BB133111EB);
+	return x ^ (x >> 31);
+}
+
+// Top 24 bits as a float in [0, 1)
+[[nodiscard]] constexpr
+auto to_unit(std::uint64_t x) -> float {
+	return float(x >> 40) * (1.0f / 16777216.0f);
+}
+
+struct counter_rng {
+	constexpr counter_rng(std::uint64_t seed, std::uint64_t counter = 0) : key_{mix(seed)}, counter_{counter} {}
+	[[nodiscard]] constexpr auto counter() const -> std::uint64_t { return counter_; }
+	// The n-th number without advancing
+	[[nodiscard]] constexpr auto at(std::uint64_t n) const -> std::uint64_t { return mix(key_ + n * GOLDEN_GAMMA); }
+	[[nodiscard]] constexpr auto unit_at(std::uint64_t n) const -> float { return to_unit(at(n)); }
+	constexpr auto next() -> std::uint64_t { return at(counter_++); }
+	constexpr auto skip(std::uint64_t n) -> void { counter_ += n; }
+	auto uniform(std::span<float> out) -> void {
+		for (size_t i = 0; i < out.size(); i++) {
+			out[i] = unit_at(counter_ + i);
+		}
+		counter_ += out.size();
+	}
+private:
+	std::uint64_t key_;
+	std::uint64_t counter_;
+};
+
+namespace detail {
+
+[[nodiscard]] inline
+auto is_locked(std::span<const std::uint8_t> locks, size_t i) -> bool {
+	return i < locks.size() && locks[i] != 0;
+}
+
+} // detail
+
+// Sets every unlocked value to one drawn uniformly over P's normalized
+// domain, then constrained and stepified. locks has a non-zero byte for
+// each value to leave alone and may be shorter than values, or empty.
+// Consumes one number per value, locked or not.
+template <policy P>
+auto randomize(counter_rng* rng, std::span<const std::uint8_t> locks, std::span<typename P::value_type> values) -> void {
+	using T = typename P::value_type;
+	const auto base = rng->counter();
+	for (size_t i = 0; i < values.size(); i++) {
+		const auto v = P::stepify(P::constrain(P::from_normalized(T(rng->unit_at(base + i)))));
+		values[i] = detail::is_locked(locks, i) ? values[i] : v;
+	}
+	rng->skip(values.size());
+}
+
+// Moves every unlocked value by up to amount in either direction in P's
+// normalized domain
+template <policy P>
+auto mutate(counter_rng* rng, float amount, std::span<const std::uint8_t> locks, std::span<typename P::value_type> values) -> void {
+	using T = typename P::value_type;
+	const auto base = rng->counter();
+	for (size_t i = 0; i < values.size(); i++) {
+		const auto offset = T((rng->unit_at(base + i) * 2.0f - 1.0f) * amount);
+		const auto n      = std::clamp(P::to_normalized(values[i]) + offset, T(0), T(1));
+		const auto v      = P::stepify(P::constrain(P::from_normalized(n)));
+		values[i] = detail::is_locked(locks, i) ? values[i] : v;
+	}
+	rng->skip(values.size());
+}
+
+// The same for handles, each within its own range, one loop per policy
+inline auto randomize(counter_rng* rng, std::span<any_param> params, const kind_index& index, std::span<const std::uint8_t> locks) -> void {
+	const auto base = rng->counter();
+	batch::for_each(params, index, [rng, params, locks, base](const auto& p, size_t i) {
+		if (detail::is_locked(locks, i)) { return; }
+		auto& param   = params[i];
+		const auto lo = p.to_normalized(param.min());
+		const auto hi = p.to_normalized(param.max());
+		param.apply_set_normalized(p, lo + (hi - lo) * rng->unit_at(base + i));
+		param.apply_stepify(p);
+	});
+	rng->skip(params.size());
+}
+
+inline auto mutate(counter_rng* rng, float amount, std::span<any_param> params, const kind_index& index, std::span<const std::uint8_t> locks) -> void {
+	const auto base = rng->counter();
+	batch::for_each(params, index, [rng, amount, params, locks, base](const auto& p, size_t i) {
+		if (detail::is_locked(locks, i)) { return; }
+		auto& param       = params[i];
+		const auto offset = (rng->unit_at(base + i) * 2.0f - 1.0f) * amount;
+		param.apply_set_normalized(p, std::clamp(p.to_normalized(param.value()) + offset, 0.0f, 1.0f));
+		param.apply_stepify(p);
+	});
+	rng->skip(params.size());
+}
+
+} // tweak::random
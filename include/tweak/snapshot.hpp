@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "any-param.hpp"
+
+// Snapshots of a list of parameters, and undo history stored as the
+// differences between them.
+//
+// Snapshots hold stepified values, so two snapshots differ only where a
+// value changed by at least a step and comparing them is a bitwise
+// comparison of two float arrays. That comparison is done a block at a
+// time in a branch free loop the compiler vectorizes, and only blocks
+// which differ are scanned for the individual changes.
+namespace tweak::snapshot {
+
+inline constexpr auto BLOCK_SIZE = size_t(64);
+
+struct change {
+	std::uint32_t index;
+	float before;
+	float after;
+};
+
+// A run of consecutive changed values in a history step
+struct run {
+	std::uint32_t start;
+	std::uint32_t count;
+	std::uint32_t values; // Offset of the first value
+};
+
+// Writes each parameter's stepified value, one loop per policy
+inline auto capture(std::span<const any_param> params, const kind_index& index, std::span<float> out) -> void {
+	batch::for_each(params, index, [params, out](const auto& p, size_t i) { out[i] = p.stepify(params[i].value()); });
+}
+
+[[nodiscard]] inline
+auto differs(std::span<const float> before, std::span<const float> after, size_t begin, size_t end) -> bool {
+	auto bits = std::uint32_t(0);
+	for (auto i = begin; i < end; i++) {
+		bits |= std::bit_cast<std::uint32_t>(before[i]) ^ std::bit_cast<std::uint32_t>(after[i]);
+	}
+	return bits != 0;
+}
+
+// Appends every value which differs between the snapshots to out
+inline auto diff(std::span<const float> before, std::span<const float> after, std::vector<change>* out) -> void {
+	const auto n = std::min(before.size(), after.size());
+	for (size_t block = 0; block < n; block += BLOCK_SIZE) {
+		const auto end = std::min(block + BLOCK_SIZE, n);
+		if (!differs(before, after, block, end)) { continue; }
+		for (auto i = block; i < end; i++) {
+			if (std::bit_cast<std::uint32_t>(before[i]) != std::bit_cast<std::uint32_t>(after[i])) {
+				out->push_back({static_cast<std::uint32_t>(i), before[i], after[i]});
+			}
+		}
+	}
+}
+
+// Undo history of snapshots of a fixed number of parameters. Each step
+// stores only the runs of values it changed. To go back, the state is
+// rebuilt from the last keyframe, a full snapshot, by replaying the steps
+// after it. A keyframe is added whenever the values stored since the last
+// one add up to a full snapshot, so memory grows with the amount edited
+// rather than with the number of commits.
+struct history {
+	history(std::span<const float> initial) : current_{initial.begin(), initial.end()} {
+		step_runs_.push_back(0);
+		keyframes_.push_back({0, 0});
+		keyframe_values_.assign(initial.begin(), initial.end());
+	}
+	[[nodiscard]] auto state() const -> std::span<const float> { return current_; }
+	[[nodiscard]] auto steps() const -> size_t { return step_runs_.size() - 1; }
+	[[nodiscard]] auto position() const -> size_t { return position_; }
+	[[nodiscard]] auto can_undo() const -> bool { return position_ > 0; }
+	[[nodiscard]] auto can_redo() const -> bool { return position_ < steps(); }
+	// Bytes used by stored steps and keyframes
+	[[nodiscard]] auto memory() const -> size_t {
+		return runs_.size() * sizeof(run) + values_.size() * sizeof(float) + keyframe_values_.size() * sizeof(float) + step_runs_.size() * sizeof(std::uint32_t);
+	}
+	// Records state as a new step, discarding anything that could have been
+	// redone. Returns false, recording nothing, if nothing changed.
+	auto commit(std::span<const float> state) -> bool {
+		changes_.clear();
+		diff(current_, state, &changes_);
+		if (changes_.empty()) { return false; }
+		truncate();
+		for (const auto& c : changes_) {
+			if (!runs_.empty() && step_runs_.back() < runs_.size() && runs_.back().start + runs_.back().count == c.index) {
+				runs_.back().count++;
+			}
+			else {
+				runs_.push_back({c.index, 1, static_cast<std::uint32_t>(values_.size())});
+			}
+			values_.push_back(c.after);
+			current_[c.index] = c.after;
+		}
+		step_runs_.push_back(static_cast<std::uint32_t>(runs_.size()));
+		position_++;
+		since_keyframe_ += changes_.size();
+		if (since_keyframe_ >= current_.size()) {
+			keyframes_.push_back({position_, keyframe_values_.size()});
+			keyframe_values_.insert(keyframe_values_.end(), current_.begin(), current_.end());
+			since_keyframe_ = 0;
+		}
+		return true;
+	}
+	// These return the new state, or an empty span if there is nothing to
+	// undo or redo.
+	auto undo() -> std::span<const float> {
+		if (!can_undo()) { return {}; }
+		position_--;
+		rebuild();
+		return current_;
+	}
+	auto redo() -> std::span<const float> {
+		if (!can_redo()) { return {}; }
+		apply(position_);
+		position_++;
+		return current_;
+	}
+private:
+	struct keyframe {
+		size_t position;
+		size_t values;
+	};
+	auto apply(size_t step) -> void {
+		for (auto r = step_runs_[step]; r < step_runs_[step + 1]; r++) {
+			const auto& run = runs_[r];
+			std::copy_n(values_.begin() + run.values, run.count, current_.begin() + run.start);
+		}
+	}
+	auto rebuild() -> void {
+		const auto key = std::prev(std::upper_bound(keyframes_.begin(), keyframes_.end(), position_, [](size_t pos, const keyframe& k) { return pos < k.position; }));
+		std::copy_n(keyframe_values_.begin() + key->values, current_.size(), current_.begin());
+		for (auto step = key->position; step < position_; step++) {
+			apply(step);
+		}
+	}
+	// Drop the steps and keyframes after the current position
+	auto truncate() -> void {
+		if (!can_redo()) { return; }
+		const auto runs = step_runs_[position_];
+		values_.resize(runs < runs_.size() ? runs_[runs].values : values_.size());
+		runs_.resize(runs);
+		step_runs_.resize(position_ + 1);
+		while (keyframes_.back().position > position_) {
+			keyframe_values_.resize(keyframes_.back().values);
+			keyframes_.pop_back();
+		}
+		since_keyframe_ = 0;
+		for (auto r = step_runs_[keyframes_.back().position]; r < runs_.size(); r++) {
+			since_keyframe_ += runs_[r].count;
+		}
+	}
+	std::vector<float> current_;
+	std::vector<run> runs_;
+	std::vector<float> values_;
+	std::vector<std::uint32_t> step_runs_; // Index of each step's first run, plus one past the end
+	std::vector<keyframe> keyframes_;
+	std::vector<float> keyframe_values_;
+	std::vector<change> changes_;
+	size_t position_       = 0;
+	size_t since_keyframe_ = 0;
+};
+
+} // tweak::snapshot
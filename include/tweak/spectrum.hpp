@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <vector>
+#include "convert.hpp"
+#include "extern.hpp"
+
+namespace tweak::spectrum {
+
+template <std::floating_point T>
+struct key {
+	int fft_size;
+	T sample_rate;
+	int width;
+	[[nodiscard]] auto operator==(const key&) const -> bool = default;
+};
+
+// Maps the bins of an FFT onto the pixel columns of a spectrum display
+// using convert::filter_hz_to_linear. The mapping is only rebuilt when the
+// FFT size, sample rate or width changes, so each frame just walks the
+// precomputed tables.
+template <std::floating_point T = float>
+struct bin_map {
+	auto configure(int fft_size, T sample_rate, int width) -> void {
+		const auto k = key<T>{fft_size, sample_rate, width};
+		if (valid_ && k == key_) { return; }
+		key_   = k;
+		valid_ = true;
+		rebuild();
+	}
+	[[nodiscard]] auto bin_count() const -> size_t { return positions_.size(); }
+	[[nodiscard]] auto width() const -> int { return key_.width; }
+	// Pixel position of each bin, clamped to [0, width]
+	[[nodiscard]] auto positions() const -> std::span<const T> { return positions_; }
+	// Reduce bin magnitudes to one value per pixel column. Columns covering
+	// several bins take the maximum, columns falling between two bins
+	// interpolate between them. Stops at the first column needing bins past
+	// the end of `bins`, and writes nothing if the map has fewer than two
+	// bins or no width.
+	auto group_max(std::span<const T> bins, std::span<T> out) const -> void {
+		const auto n = std::min(out.size(), first_.size());
+		for (size_t px = 0; px < n; px++) {
+			const auto first = first_[px];
+			const auto count = count_[px];
+			if (size_t(first) + (count > 0 ? count : 2u) > bins.size()) { return; }
+			if (count > 0) {
+				auto value = bins[first];
+				for (auto i = first + 1; i < first + count; i++) {
+					value = std::max(value, bins[i]);
+				}
+				out[px] = value;
+			}
+			else {
+				out[px] = math::lerp(bins[first], bins[first + 1], weight_[px]);
+			}
+		}
+	}
+private:
+	auto rebuild() -> void {
+		const auto bins  = key_.fft_size > 0 ? static_cast<size_t>(key_.fft_size / 2 + 1) : size_t(0);
+		const auto width = std::max(key_.width, 0);
+		positions_.resize(bins);
+		first_.clear();
+		count_.clear();
+		weight_.clear();
+		if (bins < 2 || width == 0) { std::fill(positions_.begin(), positions_.end(), T(0)); return; }
+		first_.resize(static_cast<size_t>(width), 0);
+		count_.resize(static_cast<size_t>(width), 0);
+		weight_.resize(static_cast<size_t>(width), T(0));
+		const auto bin_hz = key_.sample_rate / T(key_.fft_size);
+		positions_[0] = T(0);
+		for (size_t i = 1; i < bins; i++) {
+			const auto x = convert::filter_hz_to_linear(T(i) * bin_hz) * T(width);
+			positions_[i] = std::clamp(x, T(0), T(width));
+		}
+		auto bin = size_t(0);
+		for (size_t px = 0; px < first_.size(); px++) {
+			const auto lo = T(px);
+			const auto hi = T(px + 1);
+			while (bin < bins && positions_[bin] < lo) { bin++; }
+			auto end = bin;
+			while (end < bins && positions_[end] < hi) { end++; }
+			if (end > bin) {
+				first_[px] = static_cast<unsigned>(bin);
+				count_[px] = static_cast<unsigned>(end - bin);
+				continue;
+			}
+			// No bin starts inside this column so interpolate between the
+			// bins either side of its centre.
+			const auto right = std::clamp(bin, size_t(1), bins - 1);
+			const auto left  = right - 1;
+			const auto span  = positions_[right] - positions_[left];
+			first_[px]  = static_cast<unsigned>(left);
+			weight_[px] = span > T(0) ? std::clamp((lo + T(0.5) - positions_[left]) / span, T(0), T(1)) : T(0);
+		}
+	}
+	key<T> key_ = {};
+	bool valid_ = false;
+	std::vector<T> positions_;
+	std::vector<unsigned> first_;
+	std::vector<unsigned> count_;
+	std::vector<T> weight_;
+};
+
+// Convert linear magnitudes to decibels, clamping silence to floor_db.
+template <std::floating_point T>
+auto magnitude_to_db(std::span<const T> in, std::span<T> out, T floor_db = T(-120)) -> void {
+	const auto n     = std::min(in.size(), out.size());
+	const auto floor = convert::db_to_linear(floor_db);
+	for (size_t i = 0; i < n; i++) {
+		out[i] = T(20) * std::log10(std::max(in[i], floor));
+	}
+}
+
+} // tweak::spectrum
+
+#if defined(TWEAK_COMPILED)
+namespace tweak::spectrum {
+TWEAK_EXTERN template struct bin_map<float>;
+TWEAK_EXTERN template auto magnitude_to_db<float>(std::span<const float>, std::span<float>, float) -> void;
+TWEAK_EXTERN template struct bin_map<double>;
+TWEAK_EXTERN template auto magnitude_to_db<double>(std::span<const double>, std::span<double>, double) -> void;
+} // tweak::spectrum
+#endif
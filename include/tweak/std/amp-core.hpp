@@ -0,0 +1,117 @@
+#pragma once
+
+#include <limits>
+#include "../convert.hpp"
+#include "../step.hpp"
+
+namespace tweak::std_::amp {
+
+inline constexpr auto SILENT = 0.0f;
+inline constexpr auto MIN_DB = -60.0f;
+inline constexpr auto MAX_DB = 12.0f;
+
+template <std::floating_point T> constexpr auto MIN_LINEAR = convert::db_to_linear(T(MIN_DB));
+template <std::floating_point T> constexpr auto MAX_LINEAR = convert::db_to_linear(T(MAX_DB));
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto stepify(T v) -> T {
+	constexpr auto MIN_THRESHOLD = T(0.00001);
+	if (v <= MIN_THRESHOLD) { return SILENT; }
+	else                    { return convert::db_to_linear(math::stepify(convert::linear_to_db(v), T(0.1))); }
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto constrain(T v) -> T {
+	     if (v < MIN_LINEAR<T>) { return SILENT; }
+	else if (v > MAX_LINEAR<T>) { return MAX_LINEAR<T>; }
+	else                        { return v; }
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto increment(T v, bool precise) -> T {
+	if (v <= SILENT) { return MIN_LINEAR<T>; }
+	else             { return convert::db_to_linear(tweak::increment<1, 10>(convert::linear_to_db(v), precise)); }
+};
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto decrement(T v, bool precise) -> T {
+	if (v <= SILENT) { return v; }
+	else             { return convert::db_to_linear(tweak::decrement<1, 10>(convert::linear_to_db(v), precise)); }
+};
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto drag(T v, int amount, bool precise) -> T {
+	if (v <= SILENT) { v = convert::db_to_linear(T(MIN_DB - 1)); }
+	return convert::db_to_linear(tweak::drag<float, 1, 10>(convert::linear_to_db(v), amount / 5, precise));
+};
+
+// Amplitude stored canonically in decibels. The std_::amp overloads below
+// step and constrain it without leaving the dB domain, and the linear value
+// is only computed when asked for, then cached.
+template <std::floating_point T>
+struct db_value {
+	constexpr db_value() = default;
+	constexpr db_value(T linear)
+		: db_{linear <= SILENT ? -std::numeric_limits<T>::infinity() : convert::linear_to_db(linear)}
+		, linear_{linear <= SILENT ? T(SILENT) : linear}
+		, cached_{true}
+	{}
+	[[nodiscard]] static constexpr auto from_db(T db) -> db_value {
+		auto out = db_value{};
+		out.db_     = db;
+		out.cached_ = false;
+		return out;
+	}
+	[[nodiscard]] static constexpr auto silent() -> db_value {
+		return from_db(-std::numeric_limits<T>::infinity());
+	}
+	[[nodiscard]] constexpr auto db() const -> T { return db_; }
+	[[nodiscard]] constexpr auto is_silent() const -> bool { return db_ == -std::numeric_limits<T>::infinity(); }
+	[[nodiscard]] constexpr auto linear() const -> T {
+		if (!cached_) {
+			linear_ = is_silent() ? T(SILENT) : convert::db_to_linear(db_);
+			cached_ = true;
+		}
+		return linear_;
+	}
+	[[nodiscard]] constexpr operator T() const { return linear(); }
+	[[nodiscard]] constexpr auto operator==(const db_value& rhs) const -> bool { return db_ == rhs.db_; }
+private:
+	T db_ = -std::numeric_limits<T>::infinity();
+	mutable T linear_ = T(SILENT);
+	mutable bool cached_ = true;
+};
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto stepify(db_value<T> v) -> db_value<T> {
+	constexpr auto MIN_THRESHOLD_DB = T(-100);
+	if (v.db() <= MIN_THRESHOLD_DB) { return db_value<T>::silent(); }
+	else                            { return db_value<T>::from_db(math::stepify(v.db(), T(0.1))); }
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto constrain(db_value<T> v) -> db_value<T> {
+	     if (v.db() < T(MIN_DB)) { return db_value<T>::silent(); }
+	else if (v.db() > T(MAX_DB)) { return db_value<T>::from_db(T(MAX_DB)); }
+	else                         { return v; }
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto increment(db_value<T> v, bool precise) -> db_value<T> {
+	if (v.is_silent()) { return db_value<T>::from_db(T(MIN_DB)); }
+	else               { return db_value<T>::from_db(tweak::increment<1, 10>(v.db(), precise)); }
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto decrement(db_value<T> v, bool precise) -> db_value<T> {
+	if (v.is_silent()) { return v; }
+	else               { return db_value<T>::from_db(tweak::decrement<1, 10>(v.db(), precise)); }
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto drag(db_value<T> v, int amount, bool precise) -> db_value<T> {
+	const auto db = v.is_silent() ? T(MIN_DB - 1) : v.db();
+	return db_value<T>::from_db(tweak::drag<T, 1, 10>(db, amount / 5, precise));
+}
+
+} // tweak::std_::amp
@@ -1,65 +1,79 @@
 #pragma once
 
-#include "../convert.hpp"
-#include "../tweak.hpp"
+#include "../format.hpp"
+#include "../text.hpp"
+#include "amp-core.hpp"
+#include "../extern.hpp"
 
 namespace tweak::std_::amp {
 
-static constexpr auto SILENT = 0.0f;
-
-template <std::floating_point T> [[nodiscard]] constexpr
-auto stepify(T v) -> T {
-	constexpr auto MIN_THRESHOLD = T(0.00001);
-	if (v <= MIN_THRESHOLD) { return SILENT; }
-	else                    { return convert::db_to_linear(math::stepify(convert::linear_to_db(v), T(0.1))); }
-}
-
-template <std::floating_point T> [[nodiscard]] constexpr
-auto constrain(T v) -> T {
-	const auto db = convert::linear_to_db(v);
-	     if (db < -60.0f) { return SILENT; }
-	else if (db > 12.0f)  { return convert::db_to_linear(12.0f); }
-	else                  { return v; }
-}
-
 template <std::floating_point T = float> [[nodiscard]]
-auto from_string(const std::string& str) -> std::optional<T> {
+auto from_string(std::string_view str) -> std::optional<T> {
 	auto db = tweak::find_number<float>(str);
 	if (!db) { return db; }
 	else     { return convert::db_to_linear(*db); }
 }
 
+template <std::floating_point T> [[nodiscard]]
+auto db_to_label(T db) -> label {
+	auto out = label{};
+	out.append(db).append(" dB");
+	return out;
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto to_label(T v) -> label {
+	if (v <= SILENT) { return label{"Silent"}; }
+	else             { return db_to_label(math::stepify(convert::linear_to_db(v), T(0.1))); }
+}
+
 template <std::floating_point T> [[nodiscard]]
 auto db_to_string(T db) -> std::string {
-	auto ss = std::stringstream{};
-	ss << db << " dB";
-	return ss.str();
+	return db_to_label(db).str();
 }
 
 template <std::floating_point T> [[nodiscard]]
 auto to_string(T v) -> std::string {
-	auto ss = std::stringstream{};
-	if (v <= SILENT) { ss << "Silent"; }
-	else             { ss << db_to_string(math::stepify(convert::linear_to_db(v), T(0.1))); }
-	return ss.str();
+	return to_label(v).str();
 }
 
-template <std::floating_point T> [[nodiscard]] constexpr
-auto increment(T v, bool precise) -> T {
-	if (v <= SILENT) { return convert::db_to_linear(T(-60)); }
-	else             { return convert::db_to_linear(tweak::increment<1, 10>(convert::linear_to_db(v), precise)); }
-};
+template <std::floating_point T> [[nodiscard]]
+auto to_label(db_value<T> v) -> label {
+	if (v.is_silent()) { return label{"Silent"}; }
+	else               { return db_to_label(math::stepify(v.db(), T(0.1))); }
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto to_string(db_value<T> v) -> std::string {
+	return to_label(v).str();
+}
 
-template <std::floating_point T> [[nodiscard]] constexpr
-auto decrement(T v, bool precise) -> T {
-	if (v <= SILENT) { return v; }
-	else             { return convert::db_to_linear(tweak::decrement<1, 10>(convert::linear_to_db(v), precise)); }
-};
+template <std::floating_point T = float> [[nodiscard]]
+auto db_value_from_string(std::string_view str) -> std::optional<db_value<T>> {
+	auto db = tweak::find_number<T>(str);
+	if (!db) { return std::nullopt; }
+	else     { return db_value<T>::from_db(*db); }
+}
 
-template <std::floating_point T> [[nodiscard]] constexpr
-auto drag(T v, int amount, bool precise) -> T {
-	if (v <= SILENT) { v = convert::db_to_linear(T(-61)); }
-	return convert::db_to_linear(tweak::drag<float, 1, 10>(convert::linear_to_db(v), amount / 5, precise));
-};
+} // tweak::std_::amp
 
+#if defined(TWEAK_COMPILED)
+namespace tweak::std_::amp {
+TWEAK_EXTERN template auto from_string<float>(std::string_view) -> std::optional<float>;
+TWEAK_EXTERN template auto db_to_label<float>(float) -> label;
+TWEAK_EXTERN template auto to_label<float>(float) -> label;
+TWEAK_EXTERN template auto db_to_string<float>(float) -> std::string;
+TWEAK_EXTERN template auto to_string<float>(float) -> std::string;
+TWEAK_EXTERN template auto to_label<float>(db_value<float>) -> label;
+TWEAK_EXTERN template auto to_string<float>(db_value<float>) -> std::string;
+TWEAK_EXTERN template auto db_value_from_string<float>(std::string_view) -> std::optional<db_value<float>>;
+TWEAK_EXTERN template auto from_string<double>(std::string_view) -> std::optional<double>;
+TWEAK_EXTERN template auto db_to_label<double>(double) -> label;
+TWEAK_EXTERN template auto to_label<double>(double) -> label;
+TWEAK_EXTERN template auto db_to_string<double>(double) -> std::string;
+TWEAK_EXTERN template auto to_string<double>(double) -> std::string;
+TWEAK_EXTERN template auto to_label<double>(db_value<double>) -> label;
+TWEAK_EXTERN template auto to_string<double>(db_value<double>) -> std::string;
+TWEAK_EXTERN template auto db_value_from_string<double>(std::string_view) -> std::optional<db_value<double>>;
 } // tweak::std_::amp
+#endif
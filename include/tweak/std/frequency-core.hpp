@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include "../convert.hpp"
+#include "../lut.hpp"
+#include "../step.hpp"
+
+namespace tweak::std_::frequency {
+
+// The same range as convert::linear_to_filter_hz
+inline constexpr auto MIN_PITCH = -8.513f;
+inline constexpr auto MAX_PITCH = 135.076f;
+
+template <std::floating_point T> constexpr auto MIN = convert::pitch_to_frequency(T(MIN_PITCH));
+template <std::floating_point T> constexpr auto MAX = convert::pitch_to_frequency(T(MAX_PITCH));
+
+// log2 of the frequency of MIDI note 0 (8.1758 Hz)
+template <std::floating_point T> constexpr auto LOG2_PITCH_ZERO = T(3.0313599);
+
+template <std::floating_point T> [[nodiscard]]
+auto to_pitch(T hz) -> T {
+	return T(12) * (lut::log2(hz) - LOG2_PITCH_ZERO<T>);
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto from_pitch(T pitch) -> T {
+	return lut::exp2(pitch / T(12) + LOG2_PITCH_ZERO<T>);
+}
+
+// Equivalent to convert::filter_hz_to_linear
+template <std::floating_point T> [[nodiscard]]
+auto to_linear(T hz) -> T {
+	return math::inverse_lerp(T(MIN_PITCH), T(MAX_PITCH), to_pitch(hz));
+}
+
+// Equivalent to convert::linear_to_filter_hz
+template <std::floating_point T> [[nodiscard]]
+auto from_linear(T v) -> T {
+	return from_pitch(math::lerp(T(MIN_PITCH), T(MAX_PITCH), v));
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto constrain(T v) -> T {
+	return std::clamp(v, MIN<T>, MAX<T>);
+}
+
+// Hundredths of a semitone
+template <std::floating_point T> [[nodiscard]]
+auto stepify(T v) -> T {
+	return from_pitch(math::stepify(to_pitch(v), T(0.01)));
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto increment(T v, bool precise) -> T {
+	return constrain(from_pitch(tweak::increment<1, 10>(to_pitch(v), precise)));
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto decrement(T v, bool precise) -> T {
+	return constrain(from_pitch(tweak::decrement<1, 10>(to_pitch(v), precise)));
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto drag(T v, int amount, bool precise) -> T {
+	return constrain(from_pitch(tweak::drag<T, 1, 10>(to_pitch(v), amount / 5, precise)));
+}
+
+template <std::floating_point T>
+auto to_pitch(std::span<const T> hz, std::span<T> out) -> void {
+	const auto n = std::min(hz.size(), out.size());
+	for (size_t i = 0; i < n; i++) {
+		out[i] = to_pitch(hz[i]);
+	}
+}
+
+template <std::floating_point T>
+auto from_pitch(std::span<const T> pitch, std::span<T> out) -> void {
+	const auto n = std::min(pitch.size(), out.size());
+	for (size_t i = 0; i < n; i++) {
+		out[i] = from_pitch(pitch[i]);
+	}
+}
+
+// Normalized modulation to Hz, constrained to the valid range
+template <std::floating_point T>
+auto from_linear(std::span<const T> v, std::span<T> out) -> void {
+	const auto n = std::min(v.size(), out.size());
+	for (size_t i = 0; i < n; i++) {
+		out[i] = constrain(from_linear(v[i]));
+	}
+}
+
+template <std::floating_point T>
+auto to_linear(std::span<const T> hz, std::span<T> out) -> void {
+	const auto n = std::min(hz.size(), out.size());
+	for (size_t i = 0; i < n; i++) {
+		out[i] = to_linear(hz[i]);
+	}
+}
+
+} // tweak::std_::frequency
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <span>
+#include "../extern.hpp"
+#include "../format.hpp"
+#include "../parse.hpp"
+#include "../text.hpp"
+#include "frequency-core.hpp"
+
+namespace tweak::std_::frequency {
+
+// "55.2 Hz", "440 Hz", "1.25 kHz"
+template <std::floating_point T> [[nodiscard]]
+auto to_label(T hz) -> label {
+	auto out = label{};
+	if (hz < T(100)) {
+		const auto rounded = math::stepify(hz, T(0.1));
+		if (rounded < T(100)) { return out.append(rounded).append(" Hz"); }
+	}
+	const auto rounded = math::stepify(hz, T(1));
+	if (rounded < T(1000)) { return out.append(rounded).append(" Hz"); }
+	return out.append(math::stepify(hz / T(1000), T(0.01))).append(" kHz");
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto to_string(T hz) -> std::string {
+	return to_label(hz).str();
+}
+
+// Accepts "440", "440hz", "1.2 kHz", "2k" and "1k2"
+template <std::floating_point T = float> [[nodiscard]]
+auto from_string(std::string_view str) -> std::optional<T> {
+	const auto number = parse::find_number<T>(str, false);
+	if (!number) { return std::nullopt; }
+	const auto pos = parse::skip_spaces(str, number->end);
+	if (pos >= str.size() || parse::to_lower(str[pos]) != 'k') {
+		return number->value;
+	}
+	auto value = number->value;
+	if (pos == number->end) {
+		if (const auto decimals = parse::number_at<long long>(str, pos + 1)) {
+			auto scale = T(1);
+			for (auto i = decimals->begin; i < decimals->end; i++) { scale *= T(10); }
+			value += T(decimals->value) / scale;
+		}
+	}
+	return value * T(1000);
+}
+
+template <std::floating_point T>
+auto to_label(std::span<const T> in, std::span<label> out) -> void {
+	const auto n = std::min(in.size(), out.size());
+	for (size_t i = 0; i < n; i++) {
+		out[i] = to_label(in[i]);
+	}
+}
+
+} // tweak::std_::frequency
+
+#if defined(TWEAK_COMPILED)
+namespace tweak::std_::frequency {
+TWEAK_EXTERN template auto to_label<float>(float) -> label;
+TWEAK_EXTERN template auto to_string<float>(float) -> std::string;
+TWEAK_EXTERN template auto from_string<float>(std::string_view) -> std::optional<float>;
+TWEAK_EXTERN template auto to_label<float>(std::span<const float>, std::span<label>) -> void;
+TWEAK_EXTERN template auto to_pitch<float>(std::span<const float>, std::span<float>) -> void;
+TWEAK_EXTERN template auto from_pitch<float>(std::span<const float>, std::span<float>) -> void;
+TWEAK_EXTERN template auto to_linear<float>(std::span<const float>, std::span<float>) -> void;
+TWEAK_EXTERN template auto from_linear<float>(std::span<const float>, std::span<float>) -> void;
+TWEAK_EXTERN template auto to_label<double>(double) -> label;
+TWEAK_EXTERN template auto to_string<double>(double) -> std::string;
+TWEAK_EXTERN template auto from_string<double>(std::string_view) -> std::optional<double>;
+TWEAK_EXTERN template auto to_label<double>(std::span<const double>, std::span<label>) -> void;
+TWEAK_EXTERN template auto to_pitch<double>(std::span<const double>, std::span<double>) -> void;
+TWEAK_EXTERN template auto from_pitch<double>(std::span<const double>, std::span<double>) -> void;
+TWEAK_EXTERN template auto to_linear<double>(std::span<const double>, std::span<double>) -> void;
+TWEAK_EXTERN template auto from_linear<double>(std::span<const double>, std::span<double>) -> void;
+} // tweak::std_::frequency
+#endif
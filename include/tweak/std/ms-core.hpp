@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include "../convert.hpp"
+#include "../lut.hpp"
+#include "../step.hpp"
+
+namespace tweak::std_::ms {
+
+// Times are in milliseconds. Anything below MIN_NONZERO is treated as zero
+// since it can't be reached in the log domain.
+inline constexpr auto ZERO        = 0.0f;
+inline constexpr auto MIN_NONZERO = 0.1f;
+inline constexpr auto MAX         = 60000.0f;
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto stepify(T v) -> T {
+	return math::stepify(v, T(0.001));
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto constrain(T v) -> T {
+	     if (v < T(MIN_NONZERO)) { return ZERO; }
+	else if (v > T(MAX))         { return MAX; }
+	else                         { return v; }
+}
+
+// Steps are an eighth of an octave, or an eightieth when precise
+template <std::floating_point T> [[nodiscard]]
+auto increment(T v, bool precise) -> T {
+	if (v < T(MIN_NONZERO)) { return MIN_NONZERO; }
+	else                    { return constrain(lut::exp2(tweak::increment<8, 80>(lut::log2(v), precise))); }
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto decrement(T v, bool precise) -> T {
+	if (v < T(MIN_NONZERO)) { return ZERO; }
+	else                    { return constrain(lut::exp2(tweak::decrement<8, 80>(lut::log2(v), precise))); }
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto drag(T v, int amount, bool precise) -> T {
+	if (v < T(MIN_NONZERO)) { v = T(MIN_NONZERO) * T(0.5); }
+	return constrain(lut::exp2(tweak::drag<T, 8, 80>(lut::log2(v), amount / 5, precise)));
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto to_samples(T ms, T sample_rate) -> T {
+	return ms * sample_rate / T(1000);
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto from_samples(T samples, T sample_rate) -> T {
+	return samples * T(1000) / sample_rate;
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto to_beats(T ms, T bpm) -> T {
+	return ms * bpm / T(60000);
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto from_beats(T beats, T bpm) -> T {
+	return beats * T(60000) / bpm;
+}
+
+template <std::floating_point T>
+auto to_samples(std::span<const T> ms, T sample_rate, std::span<T> out) -> void {
+	const auto n     = std::min(ms.size(), out.size());
+	const auto scale = sample_rate / T(1000);
+	for (size_t i = 0; i < n; i++) {
+		out[i] = ms[i] * scale;
+	}
+}
+
+// Rounded to the nearest whole sample
+template <std::floating_point T>
+auto to_samples(std::span<const T> ms, T sample_rate, std::span<std::int64_t> out) -> void {
+	const auto n     = std::min(ms.size(), out.size());
+	const auto scale = sample_rate / T(1000);
+	for (size_t i = 0; i < n; i++) {
+		out[i] = static_cast<std::int64_t>(ms[i] * scale + T(0.5));
+	}
+}
+
+} // tweak::std_::ms
@@ -1,25 +1,58 @@
 #pragma once
 
-#include "../convert.hpp"
-#include "../tweak.hpp"
+#include <initializer_list>
+#include "../extern.hpp"
+#include "../format.hpp"
+#include "../parse.hpp"
+#include "../text.hpp"
+#include "ms-core.hpp"
 
 namespace tweak::std_::ms {
 
-template <std::floating_point T> [[nodiscard]] constexpr
-auto stepify(T v) -> T {
-	return math::stepify(v, T(0.001));
+// "12.5 ms", or "1.5 s" from one second up
+template <std::floating_point T> [[nodiscard]]
+auto to_label(T v) -> label {
+	auto out = label{};
+	if (ms::stepify(v) < T(1000)) { out.append(ms::stepify(v)).append(" ms"); }
+	else                          { out.append(math::stepify(v / T(1000), T(0.001))).append(" s"); }
+	return out;
 }
 
 template <std::floating_point T> [[nodiscard]]
 auto to_string(T v) -> std::string {
-	auto ss = std::stringstream{};
-	ss << ms::stepify(v) << " ms";
-	return ss.str();
+	return to_label(v).str();
 }
 
+// Milliseconds when the number has no unit or "ms", seconds for "s",
+// "sec", "secs" or "seconds". Any other unit is rejected.
 template <std::floating_point T = float> [[nodiscard]]
-auto from_string(const std::string& str) -> T {
-	return tweak::find_positive_number<T>(str);
-};
+auto from_string(std::string_view str) -> std::optional<T> {
+	const auto number = parse::find_number<T>(str, false);
+	if (!number) { return std::nullopt; }
+	const auto start = parse::skip_spaces(str, number->end);
+	auto end         = start;
+	while (end < str.size() && parse::is_alpha(str[end])) { end++; }
+	const auto unit = str.substr(start, end - start);
+	if (unit.empty() || parse::iequals(unit, "ms")) { return number->value; }
+	for (const auto seconds : {"s", "sec", "secs", "seconds"}) {
+		if (parse::iequals(unit, seconds)) { return number->value * T(1000); }
+	}
+	return std::nullopt;
+}
 
 } // tweak::std_::ms
+
+#if defined(TWEAK_COMPILED)
+namespace tweak::std_::ms {
+TWEAK_EXTERN template auto to_label<float>(float) -> label;
+TWEAK_EXTERN template auto to_string<float>(float) -> std::string;
+TWEAK_EXTERN template auto from_string<float>(std::string_view) -> std::optional<float>;
+TWEAK_EXTERN template auto to_samples<float>(std::span<const float>, float, std::span<float>) -> void;
+TWEAK_EXTERN template auto to_samples<float>(std::span<const float>, float, std::span<std::int64_t>) -> void;
+TWEAK_EXTERN template auto to_label<double>(double) -> label;
+TWEAK_EXTERN template auto to_string<double>(double) -> std::string;
+TWEAK_EXTERN template auto from_string<double>(std::string_view) -> std::optional<double>;
+TWEAK_EXTERN template auto to_samples<double>(std::span<const double>, double, std::span<double>) -> void;
+TWEAK_EXTERN template auto to_samples<double>(std::span<const double>, double, std::span<std::int64_t>) -> void;
+} // tweak::std_::ms
+#endif
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include "../convert.hpp"
+#include "../step.hpp"
+
+namespace tweak::std_::percentage {
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto stepify(T v) -> T {
+	return tweak::math::stepify<1000>(v);
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto constrain(T v) -> T {
+	return ::std::clamp(v, T(0), T(1));
+};
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto increment(T v, bool precise) -> T {
+	return tweak::increment<100, 1000>(v, precise);
+};
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto decrement(T v, bool precise) -> T {
+	return tweak::decrement<100, 1000>(v, precise);
+};
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto drag(T v, int amount, bool precise) -> T {
+	return tweak::drag<float, 100, 1000>(v, amount / 5, precise);
+};
+
+} // tweak::std_::percentage
+
+namespace tweak::std_::percentage::bipolar {
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto constrain(T v) -> T {
+	return std::clamp(v, T(-1), T(1));
+};
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto stepify(T v) -> T {
+	return percentage::stepify(v);
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto increment(T v, bool precise) -> T {
+	return percentage::increment(v, precise);
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto decrement(T v, bool precise) -> T {
+	return percentage::decrement(v, precise);
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto drag(T v, int amount, bool precise) -> T {
+	return percentage::drag(v, amount, precise);
+}
+
+} // tweak::std_::percentage::bipolar
@@ -1,44 +1,26 @@
 #pragma once
 
-#include "../convert.hpp"
-#include "../tweak.hpp"
+#include "../format.hpp"
+#include "../text.hpp"
+#include "percentage-core.hpp"
+#include "../extern.hpp"
 
 namespace tweak::std_::percentage {
 
-template <std::floating_point T> [[nodiscard]] constexpr
-auto stepify(T v) -> T {
-	return tweak::math::stepify<1000>(v);
+template <std::floating_point T> [[nodiscard]]
+auto to_label(T v) -> label {
+	auto out = label{};
+	out.append(stepify(v * T(100))).append("%");
+	return out;
 }
 
-template <std::floating_point T> [[nodiscard]] constexpr
-auto constrain(T v) -> T {
-	return ::std::clamp(v, T(0), T(1));
-};
-
-template <std::floating_point T> [[nodiscard]] constexpr
-auto increment(T v, bool precise) -> T {
-	return tweak::increment<100, 1000>(v, precise);
-};
-
-template <std::floating_point T> [[nodiscard]] constexpr
-auto decrement(T v, bool precise) -> T {
-	return tweak::decrement<100, 1000>(v, precise);
-};
-
-template <std::floating_point T> [[nodiscard]] constexpr
-auto drag(T v, int amount, bool precise) -> T {
-	return tweak::drag<float, 100, 1000>(v, amount / 5, precise);
-};
-
 template <std::floating_point T> [[nodiscard]]
 auto to_string(T v) -> std::string {
-	auto ss = std::stringstream{};
-	ss << stepify(v * T(100)) << "%";
-	return ss.str();
+	return to_label(v).str();
 }
 
 template <std::floating_point T = float> [[nodiscard]]
-auto from_string(const std::string& str) -> std::optional<T> {
+auto from_string(std::string_view str) -> std::optional<T> {
 	auto value = tweak::find_number<float>(str);
 	if (!value) { return std::nullopt; }
 	else        { return (*value / T(100)); }
@@ -46,12 +28,13 @@ auto from_string(const std::string& str) -> std::optional<T> {
 
 } // tweak::std_::percentage
 
-namespace tweak::std_::percentage::bipolar {
-
-template <std::floating_point T> [[nodiscard]] constexpr
-auto constrain(T v) -> T {
-	return std::clamp(v, T(-1), T(1));
-};
-
-} // tweak::std_::percentage::bipolar
-
+#if defined(TWEAK_COMPILED)
+namespace tweak::std_::percentage {
+TWEAK_EXTERN template auto to_label<float>(float) -> label;
+TWEAK_EXTERN template auto to_string<float>(float) -> std::string;
+TWEAK_EXTERN template auto from_string<float>(std::string_view) -> std::optional<float>;
+TWEAK_EXTERN template auto to_label<double>(double) -> label;
+TWEAK_EXTERN template auto to_string<double>(double) -> std::string;
+TWEAK_EXTERN template auto from_string<double>(std::string_view) -> std::optional<double>;
+} // tweak::std_::percentage
+#endif
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "../convert.hpp"
+#include "../step.hpp"
+
+namespace tweak::std_::pitch {
+
+// Pitches are in semitones, as MIDI note numbers (C4 = 60)
+inline constexpr auto MIN = 0.0f;
+inline constexpr auto MAX = 127.0f;
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto constrain(T v) -> T {
+	return std::clamp(v, T(MIN), T(MAX));
+}
+
+// Whole cents
+template <std::floating_point T> [[nodiscard]] constexpr
+auto stepify(T v) -> T {
+	return math::stepify(v, T(0.01));
+}
+
+// A semitone, or a cent when precise
+template <std::floating_point T> [[nodiscard]] constexpr
+auto increment(T v, bool precise) -> T {
+	return tweak::increment<1, 100>(v, precise);
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto decrement(T v, bool precise) -> T {
+	return tweak::decrement<1, 100>(v, precise);
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto drag(T v, int amount, bool precise) -> T {
+	return tweak::drag<T, 1, 100>(v, amount / 5, precise);
+}
+
+namespace scales {
+
+inline constexpr auto CHROMATIC        = std::array{0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f, 9.0f, 10.0f, 11.0f};
+inline constexpr auto MAJOR            = std::array{0.0f, 2.0f, 4.0f, 5.0f, 7.0f, 9.0f, 11.0f};
+inline constexpr auto NATURAL_MINOR    = std::array{0.0f, 2.0f, 3.0f, 5.0f, 7.0f, 8.0f, 10.0f};
+inline constexpr auto HARMONIC_MINOR   = std::array{0.0f, 2.0f, 3.0f, 5.0f, 7.0f, 8.0f, 11.0f};
+inline constexpr auto MAJOR_PENTATONIC = std::array{0.0f, 2.0f, 4.0f, 7.0f, 9.0f};
+inline constexpr auto MINOR_PENTATONIC = std::array{0.0f, 3.0f, 5.0f, 7.0f, 10.0f};
+
+} // scales
+
+// Quantizes pitches to the nearest degree of a scale. The degrees may be
+// fractional (microtonal) and the period doesn't have to be an octave.
+//
+// The period is divided into cells no wider than the smallest gap between
+// two degrees, up to MAX_CELLS, and each cell stores the index of the first
+// decision boundary after its start. When no more than one boundary
+// falls inside a cell, which is every cell unless the degrees are closer
+// together than period / MAX_CELLS, quantizing a pitch is one table lookup
+// and one comparison. Otherwise the boundaries in the cell are binary
+// searched.
+template <std::floating_point T = float>
+struct scale {
+	static constexpr auto MAX_CELLS = size_t(4096);
+	scale() : scale{scales::CHROMATIC} {}
+	template <class Degrees>
+	scale(const Degrees& degrees, T root = T(0), T period = T(12)) {
+		auto sorted = std::vector<T>{};
+		for (const auto degree : degrees) {
+			auto d = T(degree) - period * std::floor(T(degree) / period);
+			// Rounding can wrap a degree just below 0 to the period itself
+			if (d >= period) { d = T(0); }
+			sorted.push_back(d);
+		}
+		std::sort(sorted.begin(), sorted.end());
+		sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+		if (sorted.empty()) { sorted.push_back(T(0)); }
+		root_   = root;
+		period_ = period;
+		auto min_gap = period;
+		for (size_t i = 0; i < sorted.size(); i++) {
+			const auto next = i + 1 < sorted.size() ? sorted[i + 1] : sorted[0] + period;
+			min_gap = std::min(min_gap, next - sorted[i]);
+		}
+		const auto cells = static_cast<size_t>(std::min(std::ceil(period / min_gap), T(MAX_CELLS)));
+		cell_scale_ = T(cells) / period;
+		// Degrees extended by one on each side so every pitch has a neighbour
+		// either side, and the boundaries halfway between them
+		degrees_.push_back(sorted.back() - period);
+		degrees_.insert(degrees_.end(), sorted.begin(), sorted.end());
+		degrees_.push_back(sorted.front() + period);
+		for (size_t i = 0; i + 1 < degrees_.size(); i++) {
+			boundaries_.push_back((degrees_[i] + degrees_[i + 1]) / T(2));
+		}
+		first_.resize(cells + 1);
+		for (size_t cell = 0; cell <= cells; cell++) {
+			const auto lo = T(cell) / cell_scale_;
+			first_[cell]  = static_cast<std::uint32_t>(std::upper_bound(boundaries_.begin(), boundaries_.end(), lo) - boundaries_.begin());
+		}
+	}
+	[[nodiscard]] auto root() const -> T { return root_; }
+	[[nodiscard]] auto period() const -> T { return period_; }
+	[[nodiscard]] auto quantize(T v) const -> T {
+		const auto p      = v - root_;
+		const auto repeat = std::floor(p / period_);
+		const auto r      = p - repeat * period_;
+		const auto cell   = std::min(static_cast<size_t>(std::max(T(0), r * cell_scale_)), first_.size() - 2); // NaN goes to 0
+		// The boundaries from the cell's start to the next cell's start, widened
+		// in case rounding put r in the cell next to its own
+		auto lo = size_t(first_[cell]);
+		auto hi = size_t(first_[cell + 1]);
+		while (lo > 0 && r < boundaries_[lo - 1])               { lo--; }
+		while (hi < boundaries_.size() && r >= boundaries_[hi]) { hi++; }
+		const auto i = hi - lo == 1
+			? lo + (r >= boundaries_[lo] ? 1 : 0)
+			: static_cast<size_t>(std::upper_bound(boundaries_.begin() + lo, boundaries_.begin() + hi, r) - boundaries_.begin());
+		return degrees_[i] + repeat * period_ + root_;
+	}
+	auto quantize(std::span<const T> in, std::span<T> out) const -> void {
+		const auto n = std::min(in.size(), out.size());
+		for (size_t i = 0; i < n; i++) {
+			out[i] = quantize(in[i]);
+		}
+	}
+private:
+	T root_;
+	T period_;
+	T cell_scale_;
+	std::vector<T> degrees_;           // Sorted, with one more on each side
+	std::vector<T> boundaries_;        // Halfway between each pair of degrees
+	std::vector<std::uint32_t> first_; // First boundary after each cell's start
+};
+
+} // tweak::std_::pitch
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <string_view>
+#include "../extern.hpp"
+#include "../format.hpp"
+#include "../parse.hpp"
+#include "../text.hpp"
+#include "pitch-core.hpp"
+
+namespace tweak::std_::pitch {
+
+inline constexpr auto NOTE_NAMES = std::array<std::string_view, 12>{
+	"C", "C#", "D", "D#", "E", "F", "F#", "G", "G#", "A", "A#", "B"
+};
+
+// Semitones above C for each letter from A to G
+inline constexpr auto LETTER_SEMITONES = std::array{9, 11, 0, 2, 4, 5, 7};
+
+// "+7 st", "-35 ct", "+7 st +35 ct"
+template <std::floating_point T> [[nodiscard]]
+auto offset_to_label(T v) -> label {
+	auto out         = label{};
+	const auto cents = static_cast<long long>(std::round(v * T(100)));
+	const auto st    = cents / 100;
+	const auto ct    = cents % 100;
+	if (st == 0 && ct == 0) {
+		return out.append("0 st");
+	}
+	if (st != 0) {
+		out.append(st > 0 ? "+" : "").append(st).append(" st");
+	}
+	if (ct != 0) {
+		if (st != 0) { out.append(" "); }
+		out.append(ct > 0 ? "+" : "").append(ct).append(" ct");
+	}
+	return out;
+}
+
+// "C#4", "A4 +12 ct"
+template <std::floating_point T> [[nodiscard]]
+auto to_label(T v) -> label {
+	auto out         = label{};
+	const auto cents = static_cast<long long>(std::round(v * T(100)));
+	const auto note  = (cents + (cents >= 0 ? 50 : -50)) / 100;
+	const auto ct    = cents - note * 100;
+	const auto index = ((note % 12) + 12) % 12;
+	const auto oct   = (note - index) / 12 - 1;
+	out.append(NOTE_NAMES[index]).append(oct);
+	if (ct != 0) {
+		out.append(ct > 0 ? " +" : " ").append(ct).append(" ct");
+	}
+	return out;
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto offset_to_string(T v) -> std::string {
+	return offset_to_label(v).str();
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto to_string(T v) -> std::string {
+	return to_label(v).str();
+}
+
+// Parses a note name at str[pos], e.g. "C#4", "Db3", "a-1". The octave
+// defaults to 4 if it is left out. Returns the pitch and the end position.
+template <std::floating_point T> [[nodiscard]]
+auto note_at(std::string_view str, size_t pos) -> std::optional<parse::number<T>> {
+	if (pos >= str.size()) { return std::nullopt; }
+	const auto letter = parse::to_lower(str[pos]);
+	if (letter < 'a' || letter > 'g') { return std::nullopt; }
+	const auto boundary = [&str](size_t i) {
+		return i >= str.size() || str[i] == ' ' || str[i] == '-' || str[i] == '+' || parse::is_digit(str[i]);
+	};
+	auto end        = pos + 1;
+	auto semitones  = LETTER_SEMITONES[letter - 'a'];
+	if (end < str.size() && (str[end] == '#' || str[end] == 'b') && boundary(end + 1)) {
+		semitones += str[end] == '#' ? 1 : -1;
+		end++;
+	}
+	if (!boundary(end)) { return std::nullopt; }
+	auto octave   = 4;
+	const auto negative = end < str.size() && str[end] == '-' && end + 1 < str.size() && parse::is_digit(str[end + 1]);
+	if (const auto number = parse::number_at<int>(str, negative ? end + 1 : end)) {
+		octave = negative ? -number->value : number->value;
+		end    = number->end;
+	}
+	return parse::number<T>{T((octave + 1) * 12 + semitones), pos, end};
+}
+
+// Accepts note names ("C#4", "A4 +12 ct"), plain semitone values and
+// offsets with units ("+7 st", "-35 ct", "7 st 35 ct"). Each number is
+// semitones unless followed by "ct" or "cent".
+template <std::floating_point T = float> [[nodiscard]]
+auto from_string(std::string_view str) -> std::optional<T> {
+	auto total = T(0);
+	auto found = false;
+	auto pos   = parse::skip_spaces(str, 0);
+	if (const auto note = note_at<T>(str, pos)) {
+		total = note->value;
+		found = true;
+		pos   = note->end;
+	}
+	while (pos < str.size()) {
+		const auto number = parse::find_number<T>(str.substr(pos), true);
+		if (!number) { break; }
+		const auto end  = pos + number->end;
+		const auto unit = parse::skip_spaces(str, end);
+		const auto cents = unit + 1 < str.size() && parse::to_lower(str[unit]) == 'c' && (parse::to_lower(str[unit + 1]) == 't' || parse::to_lower(str[unit + 1]) == 'e');
+		total += cents ? number->value / T(100) : number->value;
+		found  = true;
+		pos    = end;
+	}
+	if (!found) { return std::nullopt; }
+	return total;
+}
+
+} // tweak::std_::pitch
+
+#if defined(TWEAK_COMPILED)
+namespace tweak::std_::pitch {
+TWEAK_EXTERN template auto offset_to_label<float>(float) -> label;
+TWEAK_EXTERN template auto to_label<float>(float) -> label;
+TWEAK_EXTERN template auto offset_to_string<float>(float) -> std::string;
+TWEAK_EXTERN template auto to_string<float>(float) -> std::string;
+TWEAK_EXTERN template auto from_string<float>(std::string_view) -> std::optional<float>;
+TWEAK_EXTERN template struct scale<float>;
+TWEAK_EXTERN template auto offset_to_label<double>(double) -> label;
+TWEAK_EXTERN template auto to_label<double>(double) -> label;
+TWEAK_EXTERN template auto offset_to_string<double>(double) -> std::string;
+TWEAK_EXTERN template auto to_string<double>(double) -> std::string;
+TWEAK_EXTERN template auto from_string<double>(std::string_view) -> std::optional<double>;
+TWEAK_EXTERN template struct scale<double>;
+} // tweak::std_::pitch
+#endif
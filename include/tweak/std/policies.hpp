@@ -0,0 +1,201 @@
+#pragma once
+
+#include "../extern.hpp"
+#include "../lut.hpp"
+#include "../policy.hpp"
+#include "amp.hpp"
+#include "frequency.hpp"
+#include "ms.hpp"
+#include "percentage.hpp"
+#include "pitch.hpp"
+#include "ratio.hpp"
+#include "speed.hpp"
+
+// Each std_ namespace wrapped up as a tweak::policy, so generic code can
+// take the kind of parameter as a template argument.
+namespace tweak::std_::policies {
+
+// Linear gain, stepped in dB. Normalized over [MIN_DB, MAX_DB] with
+// silence at 0.
+template <std::floating_point T = float>
+struct amp {
+	using value_type = T;
+	static constexpr auto MIN     = T(std_::amp::SILENT);
+	static constexpr auto MAX     = std_::amp::MAX_LINEAR<T>;
+	static constexpr auto DEFAULT = T(1);
+	static constexpr auto DOMAIN  = domain::db;
+	static constexpr auto STEPS   = steps{1, 10};
+	[[nodiscard]] static constexpr auto constrain(T v) -> T { return std_::amp::constrain(v); }
+	[[nodiscard]] static constexpr auto stepify(T v) -> T { return std_::amp::stepify(v); }
+	[[nodiscard]] static constexpr auto increment(T v, bool precise) -> T { return std_::amp::increment(v, precise); }
+	[[nodiscard]] static constexpr auto decrement(T v, bool precise) -> T { return std_::amp::decrement(v, precise); }
+	[[nodiscard]] static constexpr auto drag(T v, int amount, bool precise) -> T { return std_::amp::drag(v, amount, precise); }
+	[[nodiscard]] static constexpr auto to_normalized(T v) -> T {
+		if (v < std_::amp::MIN_LINEAR<T>) { return T(0); }
+		else                              { return std::clamp(math::inverse_lerp(T(std_::amp::MIN_DB), T(std_::amp::MAX_DB), convert::linear_to_db(v)), T(0), T(1)); }
+	}
+	[[nodiscard]] static constexpr auto from_normalized(T v) -> T {
+		if (v <= T(0)) { return MIN; }
+		else           { return convert::db_to_linear(math::lerp(T(std_::amp::MIN_DB), T(std_::amp::MAX_DB), std::min(v, T(1)))); }
+	}
+	[[nodiscard]] static auto to_label(T v) -> label { return std_::amp::to_label(v); }
+	[[nodiscard]] static auto from_string(std::string_view str) -> std::optional<T> { return std_::amp::from_string<T>(str); }
+};
+
+template <std::floating_point T = float>
+struct frequency {
+	using value_type = T;
+	static constexpr auto MIN     = std_::frequency::MIN<T>;
+	static constexpr auto MAX     = std_::frequency::MAX<T>;
+	static constexpr auto DEFAULT = T(1000);
+	static constexpr auto DOMAIN  = domain::log;
+	static constexpr auto STEPS   = steps{1, 10};
+	[[nodiscard]] static constexpr auto constrain(T v) -> T { return std_::frequency::constrain(v); }
+	[[nodiscard]] static auto stepify(T v) -> T { return std_::frequency::stepify(v); }
+	[[nodiscard]] static auto increment(T v, bool precise) -> T { return std_::frequency::increment(v, precise); }
+	[[nodiscard]] static auto decrement(T v, bool precise) -> T { return std_::frequency::decrement(v, precise); }
+	[[nodiscard]] static auto drag(T v, int amount, bool precise) -> T { return std_::frequency::drag(v, amount, precise); }
+	[[nodiscard]] static auto to_normalized(T v) -> T { return std_::frequency::to_linear(v); }
+	[[nodiscard]] static auto from_normalized(T v) -> T { return std_::frequency::from_linear(v); }
+	[[nodiscard]] static auto to_label(T v) -> label { return std_::frequency::to_label(v); }
+	[[nodiscard]] static auto from_string(std::string_view str) -> std::optional<T> { return std_::frequency::from_string<T>(str); }
+};
+
+// Milliseconds, normalized in log2 over [MIN_NONZERO, MAX] with zero at 0
+template <std::floating_point T = float>
+struct ms {
+	using value_type = T;
+	static constexpr auto MIN     = T(std_::ms::ZERO);
+	static constexpr auto MAX     = T(std_::ms::MAX);
+	static constexpr auto DEFAULT = T(std_::ms::ZERO);
+	static constexpr auto DOMAIN  = domain::log;
+	static constexpr auto STEPS   = steps{8, 80};
+	[[nodiscard]] static constexpr auto constrain(T v) -> T { return std_::ms::constrain(v); }
+	[[nodiscard]] static constexpr auto stepify(T v) -> T { return std_::ms::stepify(v); }
+	[[nodiscard]] static auto increment(T v, bool precise) -> T { return std_::ms::increment(v, precise); }
+	[[nodiscard]] static auto decrement(T v, bool precise) -> T { return std_::ms::decrement(v, precise); }
+	[[nodiscard]] static auto drag(T v, int amount, bool precise) -> T { return std_::ms::drag(v, amount, precise); }
+	[[nodiscard]] static auto to_normalized(T v) -> T {
+		if (v < T(std_::ms::MIN_NONZERO)) { return T(0); }
+		else                              { return std::clamp(math::inverse_lerp(lut::log2(T(std_::ms::MIN_NONZERO)), lut::log2(MAX), lut::log2(v)), T(0), T(1)); }
+	}
+	[[nodiscard]] static auto from_normalized(T v) -> T {
+		if (v <= T(0)) { return MIN; }
+		else           { return lut::exp2(math::lerp(lut::log2(T(std_::ms::MIN_NONZERO)), lut::log2(MAX), std::min(v, T(1)))); }
+	}
+	[[nodiscard]] static auto to_label(T v) -> label { return std_::ms::to_label(v); }
+	[[nodiscard]] static auto from_string(std::string_view str) -> std::optional<T> { return std_::ms::from_string<T>(str); }
+};
+
+template <std::floating_point T = float>
+struct percentage {
+	using value_type = T;
+	static constexpr auto MIN     = T(0);
+	static constexpr auto MAX     = T(1);
+	static constexpr auto DEFAULT = T(0);
+	static constexpr auto DOMAIN  = domain::linear;
+	static constexpr auto STEPS   = steps{100, 1000};
+	[[nodiscard]] static constexpr auto constrain(T v) -> T { return std_::percentage::constrain(v); }
+	[[nodiscard]] static constexpr auto stepify(T v) -> T { return std_::percentage::stepify(v); }
+	[[nodiscard]] static constexpr auto increment(T v, bool precise) -> T { return std_::percentage::increment(v, precise); }
+	[[nodiscard]] static constexpr auto decrement(T v, bool precise) -> T { return std_::percentage::decrement(v, precise); }
+	[[nodiscard]] static constexpr auto drag(T v, int amount, bool precise) -> T { return T(std_::percentage::drag(v, amount, precise)); }
+	[[nodiscard]] static constexpr auto to_normalized(T v) -> T { return v; }
+	[[nodiscard]] static constexpr auto from_normalized(T v) -> T { return v; }
+	[[nodiscard]] static auto to_label(T v) -> label { return std_::percentage::to_label(v); }
+	[[nodiscard]] static auto from_string(std::string_view str) -> std::optional<T> { return std_::percentage::from_string<T>(str); }
+};
+
+template <std::floating_point T = float>
+struct bipolar_percentage {
+	using value_type = T;
+	static constexpr auto MIN     = T(-1);
+	static constexpr auto MAX     = T(1);
+	static constexpr auto DEFAULT = T(0);
+	static constexpr auto DOMAIN  = domain::linear;
+	static constexpr auto STEPS   = steps{100, 1000};
+	[[nodiscard]] static constexpr auto constrain(T v) -> T { return std_::percentage::bipolar::constrain(v); }
+	[[nodiscard]] static constexpr auto stepify(T v) -> T { return std_::percentage::bipolar::stepify(v); }
+	[[nodiscard]] static constexpr auto increment(T v, bool precise) -> T { return std_::percentage::bipolar::increment(v, precise); }
+	[[nodiscard]] static constexpr auto decrement(T v, bool precise) -> T { return std_::percentage::bipolar::decrement(v, precise); }
+	[[nodiscard]] static constexpr auto drag(T v, int amount, bool precise) -> T { return T(std_::percentage::bipolar::drag(v, amount, precise)); }
+	[[nodiscard]] static constexpr auto to_normalized(T v) -> T { return convert::bi_to_uni(v); }
+	[[nodiscard]] static constexpr auto from_normalized(T v) -> T { return convert::uni_to_bi(v); }
+	[[nodiscard]] static auto to_label(T v) -> label { return std_::percentage::to_label(v); }
+	[[nodiscard]] static auto from_string(std::string_view str) -> std::optional<T> { return std_::percentage::from_string<T>(str); }
+};
+
+template <std::floating_point T = float>
+struct pitch {
+	using value_type = T;
+	static constexpr auto MIN     = T(std_::pitch::MIN);
+	static constexpr auto MAX     = T(std_::pitch::MAX);
+	static constexpr auto DEFAULT = T(60);
+	static constexpr auto DOMAIN  = domain::linear;
+	static constexpr auto STEPS   = steps{1, 100};
+	[[nodiscard]] static constexpr auto constrain(T v) -> T { return std_::pitch::constrain(v); }
+	[[nodiscard]] static constexpr auto stepify(T v) -> T { return std_::pitch::stepify(v); }
+	[[nodiscard]] static constexpr auto increment(T v, bool precise) -> T { return std_::pitch::increment(v, precise); }
+	[[nodiscard]] static constexpr auto decrement(T v, bool precise) -> T { return std_::pitch::decrement(v, precise); }
+	[[nodiscard]] static constexpr auto drag(T v, int amount, bool precise) -> T { return std_::pitch::drag(v, amount, precise); }
+	[[nodiscard]] static constexpr auto to_normalized(T v) -> T { return math::inverse_lerp(MIN, MAX, v); }
+	[[nodiscard]] static constexpr auto from_normalized(T v) -> T { return math::lerp(MIN, MAX, v); }
+	[[nodiscard]] static auto to_label(T v) -> label { return std_::pitch::to_label(v); }
+	[[nodiscard]] static auto from_string(std::string_view str) -> std::optional<T> { return std_::pitch::from_string<T>(str); }
+};
+
+template <std::floating_point T = float>
+struct ratio {
+	using value_type = T;
+	static constexpr auto MIN     = T(std_::ratio::MIN);
+	static constexpr auto MAX     = T(std_::ratio::INF);
+	static constexpr auto DEFAULT = T(std_::ratio::MIN);
+	static constexpr auto DOMAIN  = domain::log;
+	static constexpr auto STEPS   = steps{100, 1000};
+	[[nodiscard]] static constexpr auto constrain(T v) -> T { return std_::ratio::constrain(v); }
+	[[nodiscard]] static constexpr auto stepify(T v) -> T { return std_::ratio::stepify(v); }
+	[[nodiscard]] static auto increment(T v, bool precise) -> T { return std_::ratio::increment(v, precise); }
+	[[nodiscard]] static auto decrement(T v, bool precise) -> T { return std_::ratio::decrement(v, precise); }
+	[[nodiscard]] static auto drag(T v, int amount, bool precise) -> T { return std_::ratio::drag(v, amount, precise); }
+	[[nodiscard]] static auto to_normalized(T v) -> T { return std_::ratio::to_linear(v); }
+	[[nodiscard]] static auto from_normalized(T v) -> T { return std_::ratio::from_linear(v); }
+	[[nodiscard]] static auto to_label(T v) -> label { return std_::ratio::to_label(v); }
+	[[nodiscard]] static auto from_string(std::string_view str) -> std::optional<T> { return std_::ratio::from_string<T>(str); }
+};
+
+// Playback speed, normalized in octaves over [MIN, MAX] with FREEZE at 0
+template <std::floating_point T = float>
+struct speed {
+	using value_type = T;
+	static constexpr auto MIN     = T(std_::speed::FREEZE);
+	static constexpr auto MAX     = std_::speed::MAX<T>;
+	static constexpr auto DEFAULT = T(std_::speed::NORMAL);
+	static constexpr auto DOMAIN  = domain::log;
+	static constexpr auto STEPS   = steps{1, 10};
+	[[nodiscard]] static constexpr auto constrain(T v) -> T { return std_::speed::constrain(v); }
+	[[nodiscard]] static constexpr auto stepify(T v) -> T { return std_::speed::stepify(v); }
+	[[nodiscard]] static constexpr auto increment(T v, bool precise) -> T { return std_::speed::increment(v, precise); }
+	[[nodiscard]] static constexpr auto decrement(T v, bool precise) -> T { return std_::speed::decrement(v, precise); }
+	[[nodiscard]] static constexpr auto drag(T v, int amount, bool precise) -> T { return T(std_::speed::drag(v, amount, precise)); }
+	[[nodiscard]] static auto to_normalized(T v) -> T {
+		if (v < std_::speed::MIN<T>) { return T(0); }
+		else                         { return std::clamp(math::inverse_lerp(lut::log2(std_::speed::MIN<T>), lut::log2(MAX), lut::log2(v)), T(0), T(1)); }
+	}
+	[[nodiscard]] static auto from_normalized(T v) -> T {
+		if (v <= T(0)) { return MIN; }
+		else           { return lut::exp2(math::lerp(lut::log2(std_::speed::MIN<T>), lut::log2(MAX), std::min(v, T(1)))); }
+	}
+	[[nodiscard]] static auto to_label(T v) -> label { return std_::speed::to_label(v); }
+	[[nodiscard]] static auto from_string(std::string_view str) -> std::optional<T> { return std_::speed::from_string<T>(str); }
+};
+
+static_assert(formattable_policy<amp<>>);
+static_assert(formattable_policy<frequency<>>);
+static_assert(formattable_policy<ms<>>);
+static_assert(formattable_policy<percentage<>>);
+static_assert(formattable_policy<bipolar_percentage<>>);
+static_assert(formattable_policy<pitch<>>);
+static_assert(formattable_policy<ratio<>>);
+static_assert(formattable_policy<speed<>>);
+
+} // tweak::std_::policies
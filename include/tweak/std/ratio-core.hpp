@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <span>
+#include "../convert.hpp"
+#include "../lut.hpp"
+#include "../step.hpp"
+
+namespace tweak::std_::ratio {
+
+// Compressor ratios, N:1. Anything above MAX is infinite.
+inline constexpr auto MIN = 1.0f;
+inline constexpr auto MAX = 100.0f;
+inline constexpr auto INF = std::numeric_limits<float>::infinity();
+
+template <std::floating_point T> inline constexpr auto LOG2_MAX = T(6.6438561897747247);
+
+// Same mapping as convert::linear_to_ratio but evaluated as
+// exp2(v^2 * log2(MAX)) through the lookup tables. The top of the
+// normalized range is infinite rather than MAX.
+template <std::floating_point T> [[nodiscard]]
+auto from_linear(T v) -> T {
+	if (v <= T(0)) { return T(MIN); }
+	if (v >= T(1)) { return T(INF); }
+	return lut::exp2(v * v * LOG2_MAX<T>);
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto to_linear(T r) -> T {
+	if (r <= T(MIN)) { return T(0); }
+	if (r >  T(MAX)) { return T(1); }
+	return std::sqrt(lut::log2(r) / LOG2_MAX<T>);
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto constrain(T v) -> T {
+	     if (v < T(MIN)) { return MIN; }
+	else if (v > T(MAX)) { return INF; }
+	else                 { return v; }
+}
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto stepify(T v) -> T {
+	if (v > T(MAX)) { return INF; }
+	else            { return math::stepify(v, T(0.1)); }
+}
+
+// Steps are a hundredth of the normalized range, or a thousandth when precise
+template <std::floating_point T> [[nodiscard]]
+auto increment(T v, bool precise) -> T {
+	return constrain(from_linear(tweak::increment<100, 1000>(to_linear(v), precise)));
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto decrement(T v, bool precise) -> T {
+	return constrain(from_linear(tweak::decrement<100, 1000>(to_linear(v), precise)));
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto drag(T v, int amount, bool precise) -> T {
+	return constrain(from_linear(tweak::drag<T, 100, 1000>(to_linear(v), amount / 5, precise)));
+}
+
+// Per-sample ratios from a normalized (e.g. sidechain modulated) buffer
+template <std::floating_point T>
+auto from_linear(std::span<const T> v, std::span<T> out) -> void {
+	const auto n = std::min(v.size(), out.size());
+	for (size_t i = 0; i < n; i++) {
+		out[i] = from_linear(v[i]);
+	}
+}
+
+template <std::floating_point T>
+auto to_linear(std::span<const T> r, std::span<T> out) -> void {
+	const auto n = std::min(r.size(), out.size());
+	for (size_t i = 0; i < n; i++) {
+		out[i] = to_linear(r[i]);
+	}
+}
+
+} // tweak::std_::ratio
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../extern.hpp"
+#include "../format.hpp"
+#include "../parse.hpp"
+#include "../text.hpp"
+#include "ratio-core.hpp"
+
+namespace tweak::std_::ratio {
+
+// "4:1", "2.5:1", "inf:1"
+template <std::floating_point T> [[nodiscard]]
+auto to_label(T v) -> label {
+	auto out = label{};
+	if (v > T(MAX)) { out.append("inf"); }
+	else            { out.append(ratio::stepify(v)); }
+	out.append(":1");
+	return out;
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto to_string(T v) -> std::string {
+	return to_label(v).str();
+}
+
+// Accepts "4:1", "4", "inf" and "∞"
+template <std::floating_point T = float> [[nodiscard]]
+auto from_string(std::string_view str) -> std::optional<T> {
+	const auto number = parse::find_number<T>(str, false);
+	const auto start  = number ? number->begin : str.size();
+	for (size_t i = 0; i < start; i++) {
+		if (str.substr(i, 3) == "\xE2\x88\x9E")      { return T(INF); }
+		if (parse::iequals(str.substr(i, 3), "inf")) { return T(INF); }
+	}
+	if (!number) { return std::nullopt; }
+	return number->value;
+}
+
+} // tweak::std_::ratio
+
+#if defined(TWEAK_COMPILED)
+namespace tweak::std_::ratio {
+TWEAK_EXTERN template auto to_label<float>(float) -> label;
+TWEAK_EXTERN template auto to_string<float>(float) -> std::string;
+TWEAK_EXTERN template auto from_string<float>(std::string_view) -> std::optional<float>;
+TWEAK_EXTERN template auto from_linear<float>(std::span<const float>, std::span<float>) -> void;
+TWEAK_EXTERN template auto to_linear<float>(std::span<const float>, std::span<float>) -> void;
+TWEAK_EXTERN template auto to_label<double>(double) -> label;
+TWEAK_EXTERN template auto to_string<double>(double) -> std::string;
+TWEAK_EXTERN template auto from_string<double>(std::string_view) -> std::optional<double>;
+TWEAK_EXTERN template auto from_linear<double>(std::span<const double>, std::span<double>) -> void;
+TWEAK_EXTERN template auto to_linear<double>(std::span<const double>, std::span<double>) -> void;
+} // tweak::std_::ratio
+#endif
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <string_view>
+#include "../convert.hpp"
+#include "../step.hpp"
+
+namespace tweak::std_::speed {
+
+inline constexpr auto FREEZE       = 0.0f;
+inline constexpr auto THIRTYSECOND = 0.03125f;
+inline constexpr auto SIXTEENTH    = 0.0625f;
+inline constexpr auto EIGHTH       = 0.125f;
+inline constexpr auto QUARTER      = 0.25f;
+inline constexpr auto HALF         = 0.5f;
+inline constexpr auto NORMAL       = 1.0f;
+inline constexpr auto DOUBLE       = 2.0f;
+inline constexpr auto TRIPLE       = 3.0f;
+
+template <std::floating_point T> constexpr auto MIN = convert::linear_to_speed(T(-32));
+template <std::floating_point T> constexpr auto MAX = T(32);
+
+// Speeds within this distance of a milestone (or, for fractions, whose
+// reciprocal is within this distance of an integer) are shown by name.
+template <std::floating_point T> constexpr auto THRESHOLD = T(0.001);
+
+// A speed which is displayed by name rather than as "xN"
+struct ratio {
+    long long denominator; // 1/denominator for fractions, 0 for named milestones
+    std::string_view name; // Empty for fractions
+};
+
+template <std::floating_point T>
+struct ratio_entry {
+    T lo;
+    T hi;
+    ratio value;
+};
+
+// Fractions up to 1/MAX_DENOMINATOR are looked up in the table. Smaller
+// speeds fall back to checking the reciprocal directly.
+inline constexpr auto MAX_DENOMINATOR = 64;
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto make_ratio_table() {
+    auto out = std::array<ratio_entry<T>, MAX_DENOMINATOR - 1 + 3>{};
+    auto i   = size_t(0);
+    for (auto n = MAX_DENOMINATOR; n >= 2; n--) {
+        out[i++] = {T(1) / (T(n) + THRESHOLD<T>), T(1) / (T(n) - THRESHOLD<T>), {n, {}}};
+    }
+    out[i++] = {T(NORMAL) - THRESHOLD<T>, T(NORMAL) + THRESHOLD<T>, {0, "Normal"}};
+    out[i++] = {T(DOUBLE) - THRESHOLD<T>, T(DOUBLE) + THRESHOLD<T>, {0, "Double"}};
+    out[i++] = {T(TRIPLE) - THRESHOLD<T>, T(TRIPLE) + THRESHOLD<T>, {0, "Triple"}};
+    return out;
+}
+
+template <std::floating_point T> constexpr auto RATIOS = make_ratio_table<T>();
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto constrain(T v) -> T {
+         if (v < MIN<T>) { return FREEZE; }
+    else if (v > MAX<T>) { return MAX<T>; }
+    else                 { return v; }
+};
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto increment(T v, bool precise) -> T {
+    if (v <= FREEZE) { return MIN<T>; }
+    else             { return constrain(convert::linear_to_speed(tweak::increment<1, 10>(convert::speed_to_linear(v), precise))); }
+};
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto decrement(T v, bool precise) -> T {
+    return constrain(convert::linear_to_speed(tweak::decrement<1, 10>(convert::speed_to_linear(v), precise)));
+};
+
+template <std::floating_point T> [[nodiscard]] constexpr
+auto drag(T v, int amount, bool precise) -> T {
+    if (v <= FREEZE) { v = MIN<T>; }
+    return constrain(convert::linear_to_speed(tweak::drag<float, 1, 10>(convert::speed_to_linear(v), amount / 5, precise)));
+};
+
+// Find the musical ratio a speed should be displayed as, if any
+template <std::floating_point T> [[nodiscard]] constexpr
+auto find_ratio(T v) -> std::optional<ratio> {
+    const auto& table = RATIOS<T>;
+    if (v <= FREEZE) {
+        return std::nullopt;
+    }
+    if (v < table.front().lo) {
+        const auto recip         = T(1) / v;
+        const auto rounded_recip = const_math::floor(recip + T(0.5));
+        if (const_math::abs(recip - rounded_recip) < THRESHOLD<T>) { return ratio{static_cast<long long>(rounded_recip), {}}; }
+        return std::nullopt;
+    }
+    const auto pos = std::upper_bound(table.begin(), table.end(), v, [](T value, const ratio_entry<T>& e) { return value < e.lo; });
+    if (pos == table.begin()) { return std::nullopt; }
+    const auto& entry = *(pos - 1);
+    if (v < entry.hi) { return entry.value; }
+    return std::nullopt;
+}
+
+// Snap speeds that are displayed by name onto their exact value
+template <std::floating_point T> [[nodiscard]] constexpr
+auto stepify(T v) -> T {
+    if (v <= FREEZE) { return FREEZE; }
+    const auto r = find_ratio(v);
+    if (!r)                 { return v; }
+    if (r->denominator > 0) { return T(1) / T(r->denominator); }
+    else                    { return const_math::floor(v + T(0.5)); }
+}
+
+} // tweak::std_::speed
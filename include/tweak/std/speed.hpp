@@ -1,91 +1,178 @@
 #pragma once
 
-#include "../convert.hpp"
-#include "../tweak.hpp"
+#include <span>
+#include "../format.hpp"
+#include "../parse.hpp"
+#include "../text.hpp"
+#include "speed-core.hpp"
+#include "../extern.hpp"
 
 namespace tweak::std_::speed {
 
-constexpr auto FREEZE       = 0.0f;
-constexpr auto THIRTYSECOND = 0.03125f;
-constexpr auto SIXTEENTH    = 0.0625f;
-constexpr auto EIGHTH       = 0.125f;
-constexpr auto QUARTER      = 0.25f;
-constexpr auto HALF         = 0.5f;
-constexpr auto NORMAL       = 1.0f;
-constexpr auto DOUBLE       = 2.0f;
-constexpr auto TRIPLE       = 3.0f;
-
-template <std::floating_point T> [[nodiscard]] constexpr
-auto constrain(T v) -> T {
-         if (v < convert::linear_to_speed(T(-32))) { return FREEZE; }
-    else if (v > T(32))                            { return T(32); }
-    else                                           { return v; }
+enum class token {
+    freeze,
+    normal,
+    double_,
+    triple,
+    fraction,   // "1/N"
+    multiplier, // "xN"
+    percentage, // "N%"
+    number,
 };
 
-template <std::floating_point T> [[nodiscard]] constexpr
-auto increment(T v, bool precise) -> T {
-    if (v <= FREEZE) { return convert::linear_to_speed(T(-32)); }
-    else             { return constrain(convert::linear_to_speed(tweak::increment<1, 10>(convert::speed_to_linear(v), precise))); }
+template <std::floating_point T>
+struct parsed {
+    T value;
+    token kind;
 };
 
-template <std::floating_point T> [[nodiscard]] constexpr
-auto decrement(T v, bool precise) -> T {
-    return constrain(convert::linear_to_speed(tweak::decrement<1, 10>(convert::speed_to_linear(v), precise)));
+struct keyword {
+    std::string_view text;
+    float value;
+    token kind;
 };
 
-template <std::floating_point T> [[nodiscard]] constexpr
-auto drag(T v, int amount, bool precise) -> T {
-    if (v <= FREEZE) { v = convert::linear_to_speed(T(-32)); }
-    return constrain(convert::linear_to_speed(tweak::drag<float, 1, 10>(convert::speed_to_linear(v), amount / 5, precise)));
-};
+// In order of priority, if a string contains more than one
+inline constexpr auto KEYWORDS = std::array<keyword, 4>{{
+    {"freeze", FREEZE, token::freeze},
+    {"normal", NORMAL, token::normal},
+    {"double", DOUBLE, token::double_},
+    {"triple", TRIPLE, token::triple},
+}};
+
+inline constexpr auto KEYWORD_LENGTH = size_t(6);
+
+[[nodiscard]] constexpr
+auto keyword_hash(char c) -> size_t {
+    return static_cast<size_t>(parse::to_lower(c) & 31);
+}
 
+// Perfect hash on the first letter of each keyword
+inline constexpr auto KEYWORD_SLOTS = [] {
+    auto out = std::array<int, 32>{};
+    for (auto& slot : out) { slot = -1; }
+    for (size_t i = 0; i < KEYWORDS.size(); i++) {
+        out[keyword_hash(KEYWORDS[i].text[0])] = static_cast<int>(i);
+    }
+    return out;
+}();
+
+static_assert([] {
+    for (const auto& k : KEYWORDS) {
+        if (KEYWORDS[KEYWORD_SLOTS[keyword_hash(k.text[0])]].kind != k.kind) { return false; }
+        if (k.text.size() != KEYWORD_LENGTH)                                 { return false; }
+    }
+    return true;
+}(), "speed keywords must hash to distinct slots");
+
+// Single pass over the string. Keywords may appear anywhere and take
+// priority over "1/N", which takes priority over the first other number.
 template <std::floating_point T = float> [[nodiscard]]
-auto from_string(const std::string& str) -> std::optional<T> {
-    auto uppercase = str;
-    std::transform(str.begin(), str.end(), uppercase.begin(), ::toupper);
-    if (uppercase.find("FREEZE") != std::string::npos) { return FREEZE; }
-    if (uppercase.find("NORMAL") != std::string::npos) { return NORMAL; }
-    if (uppercase.find("DOUBLE") != std::string::npos) { return DOUBLE; }
-    if (uppercase.find("TRIPLE") != std::string::npos) { return TRIPLE; }
-    auto r     = std::regex{"1/([\\d]+)"};
-    auto match = std::smatch{};
-    if (std::regex_search(str, match, r)) {
-        return T(1) / std::stoi(match[1]);
+auto parse(std::string_view str) -> std::optional<parsed<T>> {
+    auto best_keyword = -1;
+    auto fraction     = std::optional<T>{};
+    auto first_number = std::optional<parsed<T>>{};
+    auto pos          = size_t(0);
+    while (pos < str.size()) {
+        const auto c = str[pos];
+        if (parse::is_alpha(c)) {
+            const auto slot = KEYWORD_SLOTS[keyword_hash(c)];
+            if (slot >= 0 && (best_keyword < 0 || slot < best_keyword) && str.size() - pos >= KEYWORD_LENGTH) {
+                if (parse::iequals(str.substr(pos, KEYWORD_LENGTH), KEYWORDS[slot].text)) {
+                    best_keyword = slot;
+                    if (slot == 0) { break; }
+                }
+            }
+            pos++;
+            continue;
+        }
+        const auto number = parse::number_at<T>(str, pos);
+        if (!number) {
+            pos++;
+            continue;
+        }
+        pos = number->end;
+        if (!fraction && c == '1' && number->end == number->begin + 1 && pos < str.size() && str[pos] == '/') {
+            if (const auto denominator = parse::number_at<int>(str, pos + 1); denominator && denominator->value > 0) {
+                fraction = T(1) / T(denominator->value);
+                pos      = denominator->end;
+                continue;
+            }
+        }
+        if (first_number) {
+            continue;
+        }
+        const auto prev = number->begin > 0 ? str[number->begin - 1] : '\0';
+        const auto next = parse::skip_spaces(str, number->end);
+        if (next < str.size() && str[next] == '%') { first_number = parsed<T>{number->value / T(100), token::percentage}; }
+        else if (parse::to_lower(prev) == 'x')     { first_number = parsed<T>{number->value, token::multiplier}; }
+        else if (prev == '-')                      { first_number = parsed<T>{-number->value, token::number}; }
+        else                                       { first_number = parsed<T>{number->value, token::number}; }
     }
-    auto ff = tweak::find_number<float>(str);
-    if (!ff) { return ff; }
-    return *ff;
+    if (best_keyword >= 0) { return parsed<T>{T(KEYWORDS[best_keyword].value), KEYWORDS[best_keyword].kind}; }
+    if (fraction)          { return parsed<T>{*fraction, token::fraction}; }
+    return first_number;
+}
+
+template <std::floating_point T = float> [[nodiscard]]
+auto from_string(std::string_view str) -> std::optional<T> {
+    const auto result = parse<T>(str);
+    if (!result) { return std::nullopt; }
+    return result->value;
 };
 
 template <std::floating_point T> [[nodiscard]]
-auto to_string(T v) -> std::string {
-	constexpr auto THRESHOLD = T(0.001);
-    const auto milestone_hit = [THRESHOLD](T value, T milestone) {
-        return value > milestone - THRESHOLD && value < milestone + THRESHOLD;
-    };
-    auto ss = std::stringstream{};
+auto to_label(T v) -> label {
+    auto out = label{};
     if (v <= FREEZE) {
-        ss << "Freeze";
-    }
-    else if (v < T(1) - THRESHOLD) {
-        const auto recip         = T(1) / v;
-        const auto rounded_recip = std::round(recip);
-        if (std::abs(recip - rounded_recip) < THRESHOLD) { ss << "1/" << rounded_recip; }
-        else                                             { ss << "x" << v; }
+        out.append("Freeze");
     }
-    else if (milestone_hit(v, NORMAL)) {
-        ss << "Normal";
+    else if (const auto r = find_ratio(v)) {
+        if (r->denominator > 0) { out.append("1/").append(T(r->denominator)); }
+        else                    { out.append(r->name); }
     }
-    else if (milestone_hit(v, DOUBLE)) {
-        ss << "Double";
+    else {
+        out.append("x").append(v);
     }
-    else if (milestone_hit(v, TRIPLE)) {
-        ss << "Triple";
+    return out;
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto to_string(T v) -> std::string {
+    return to_label(v).str();
+}
+
+template <std::floating_point T>
+auto to_label(std::span<const T> in, std::span<label> out) -> void {
+    const auto n = std::min(in.size(), out.size());
+    for (size_t i = 0; i < n; i++) {
+        out[i] = to_label(in[i]);
     }
-    else {
-        ss << "x" << v;
+}
+
+template <std::floating_point T>
+auto to_string(std::span<const T> in, std::span<std::string> out) -> void {
+    const auto n = std::min(in.size(), out.size());
+    for (size_t i = 0; i < n; i++) {
+        out[i].assign(to_label(in[i]).view());
     }
-    return ss.str();
 }
 
 } // tweak::std_::speed
+
+#if defined(TWEAK_COMPILED)
+namespace tweak::std_::speed {
+TWEAK_EXTERN template auto parse<float>(std::string_view) -> std::optional<parsed<float>>;
+TWEAK_EXTERN template auto from_string<float>(std::string_view) -> std::optional<float>;
+TWEAK_EXTERN template auto to_label<float>(float) -> label;
+TWEAK_EXTERN template auto to_string<float>(float) -> std::string;
+TWEAK_EXTERN template auto to_label<float>(std::span<const float>, std::span<label>) -> void;
+TWEAK_EXTERN template auto to_string<float>(std::span<const float>, std::span<std::string>) -> void;
+TWEAK_EXTERN template auto parse<double>(std::string_view) -> std::optional<parsed<double>>;
+TWEAK_EXTERN template auto from_string<double>(std::string_view) -> std::optional<double>;
+TWEAK_EXTERN template auto to_label<double>(double) -> label;
+TWEAK_EXTERN template auto to_string<double>(double) -> std::string;
+TWEAK_EXTERN template auto to_label<double>(std::span<const double>, std::span<label>) -> void;
+TWEAK_EXTERN template auto to_string<double>(std::span<const double>, std::span<std::string>) -> void;
+} // tweak::std_::speed
+#endif
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <concepts>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "format.hpp"
+#include "parse.hpp"
+#include "extern.hpp"
+
+namespace tweak {
+
+template <std::floating_point T> [[nodiscard]]
+auto find_number(std::string_view str) -> std::optional<T> {
+	const auto number = parse::find_number<T>(str, true);
+	if (!number) { return std::nullopt; }
+	else         { return number->value; }
+}
+
+template <std::integral T> [[nodiscard]]
+auto find_number(std::string_view str) -> std::optional<T> {
+	const auto number = parse::find_number<T>(str, true);
+	if (!number) { return std::nullopt; }
+	else         { return number->value; }
+}
+
+template <std::floating_point T> [[nodiscard]]
+auto find_positive_number(std::string_view str) -> std::optional<T> {
+	const auto number = parse::find_number<T>(str, false);
+	if (!number) { return std::nullopt; }
+	else         { return number->value; }
+}
+
+template <std::integral T> [[nodiscard]]
+auto find_positive_number(std::string_view str) -> std::optional<T> {
+	const auto number = parse::find_number<T>(str, false);
+	if (!number) { return std::nullopt; }
+	else         { return number->value; }
+}
+
+template <class T> requires std::is_arithmetic_v<T> [[nodiscard]]
+auto to_string(T v) -> std::string {
+	return label{}.append(v).str();
+}
+
+} // tweak
+
+#if defined(TWEAK_COMPILED)
+namespace tweak {
+TWEAK_EXTERN template auto find_number<float>(std::string_view) -> std::optional<float>;
+TWEAK_EXTERN template auto find_positive_number<float>(std::string_view) -> std::optional<float>;
+TWEAK_EXTERN template auto to_string<float>(float) -> std::string;
+TWEAK_EXTERN template auto find_number<double>(std::string_view) -> std::optional<double>;
+TWEAK_EXTERN template auto find_positive_number<double>(std::string_view) -> std::optional<double>;
+TWEAK_EXTERN template auto to_string<double>(double) -> std::string;
+} // tweak
+#endif
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include "fastmath.hpp"
+#include "std/speed-core.hpp"
+
+// Per sample phase increments for sample playback from a speed and a pitch
+// modulation buffer.
+//
+// Increments are built in double precision from the base increment, so a
+// constant speed gives the exact same increment every sample. Positions are
+// accumulated in 32.32 fixed point, where adding increments is exact, so
+// after any length of playback the position is off by at most the rounding
+// of each increment to 2^-32 of a sample: under 0.05 samples after an hour
+// at 48kHz.
+namespace tweak::varispeed {
+
+inline constexpr auto FRACTION_BITS = 32;
+inline constexpr auto ONE           = std::uint64_t(1) << FRACTION_BITS;
+
+[[nodiscard]] inline
+auto to_fixed(double v) -> std::uint64_t {
+	return static_cast<std::uint64_t>(std::llround(std::max(v, 0.0) * double(ONE)));
+}
+
+[[nodiscard]] inline
+auto from_fixed(std::uint64_t v) -> double {
+	return double(v >> FRACTION_BITS) + double(v & (ONE - 1)) / double(ONE);
+}
+
+struct generator {
+	// base is the increment at normal speed and no transposition, e.g. the
+	// sample's rate divided by the output rate. Stopping at FREEZE, or
+	// starting again from it, ramps the increment over `ramp` frames.
+	generator(double base, size_t ramp = 64) : base_{base} { set_ramp(ramp); }
+	[[nodiscard]] auto base() const -> double { return base_; }
+	[[nodiscard]] auto frozen() const -> bool { return gain_ == 0.0f; }
+	auto set_base(double base) -> void { base_ = base; }
+	auto set_ramp(size_t ramp) -> void { step_ = 1.0f / float(std::max(ramp, size_t(1))); }
+	// Jumps straight to speed with no ramp, e.g. when a voice starts
+	auto reset(float speed) -> void {
+		const auto frozen = !(speed > std_::speed::FREEZE);
+		held_ = frozen ? std_::speed::NORMAL : speed;
+		gain_ = frozen ? 0.0f : 1.0f;
+	}
+	// speed holds a speed per frame, FREEZE to stop, and pitch a
+	// transposition in semitones per frame, or is empty for none. If pitch
+	// is shorter than speed its last value holds for the remaining frames.
+	// out gets one increment per frame.
+	auto process(std::span<const float> speed, std::span<const float> pitch, std::span<double> out) -> void {
+		run(speed, pitch, out.size(), [out](size_t f, double inc) { out[f] = inc; });
+	}
+	auto process(std::span<const float> speed, std::span<const float> pitch, std::span<std::uint64_t> out) -> void {
+		run(speed, pitch, out.size(), [out](size_t f, double inc) { out[f] = to_fixed(inc); });
+	}
+private:
+	static constexpr auto CHUNK = size_t(256);
+	template <class Write>
+	auto run(std::span<const float> speed, std::span<const float> pitch, size_t size, Write&& write) -> void {
+		const auto n = std::min(speed.size(), size);
+		auto ratio   = std::array<float, CHUNK>{};
+		for (size_t start = 0; start < n; start += CHUNK) {
+			const auto count = std::min(CHUNK, n - start);
+			// Transposition, vectorized
+			const auto given = pitch.size() > start ? std::min(count, pitch.size() - start) : size_t(0);
+			const auto* p    = pitch.data() + std::min(start, pitch.size());
+			for (size_t f = 0; f < given; f++) {
+				ratio[f] = fastmath::exp2(p[f] * (1.0f / 12.0f));
+			}
+			const auto held = pitch.empty() ? 1.0f : fastmath::exp2(pitch.back() * (1.0f / 12.0f));
+			std::fill(ratio.begin() + given, ratio.begin() + count, held);
+			// The freeze ramp depends on the previous frame, so this part is serial
+			for (size_t f = 0; f < count; f++) {
+				const auto s      = speed[start + f];
+				const auto frozen = !(s > std_::speed::FREEZE);
+				held_ = frozen ? held_ : s;
+				gain_ = frozen ? std::max(gain_ - step_, 0.0f) : std::min(gain_ + step_, 1.0f);
+				write(start + f, base_ * double(held_) * double(gain_) * double(ratio[f]));
+			}
+		}
+	}
+	double base_;
+	float step_;
+	float held_ = std_::speed::NORMAL; // The last speed which wasn't FREEZE
+	float gain_ = 1.0f;                // Ramps to 0 while frozen
+};
+
+// A playback position in 32.32 fixed point. Wraps after 2^32 samples.
+struct accumulator {
+	[[nodiscard]] auto raw() const -> std::uint64_t { return phase_; }
+	[[nodiscard]] auto index() const -> std::uint32_t { return static_cast<std::uint32_t>(phase_ >> FRACTION_BITS); }
+	[[nodiscard]] auto fraction() const -> float { return float(phase_ & (ONE - 1)) * (1.0f / float(ONE)); }
+	[[nodiscard]] auto position() const -> double { return from_fixed(phase_); }
+	auto set(double position) -> void { phase_ = to_fixed(position); }
+	auto advance(std::uint64_t increment) -> void { phase_ += increment; }
+	auto advance(std::span<const std::uint64_t> increments) -> void {
+		for (const auto inc : increments) { phase_ += inc; }
+	}
+private:
+	std::uint64_t phase_ = 0;
+};
+
+} // tweak::varispeed
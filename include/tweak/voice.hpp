@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "fastmath.hpp"
+#include "policy.hpp"
+
+// Per voice parameter values for polyphonic engines, laid out with all the
+// voices' values for a parameter next to each other so that each kernel
+// works on every voice at once in loops the compiler vectorizes.
+//
+// Arrays are padded to a multiple of LANES voices and aligned to 64 bytes.
+// Voices are processed LANES at a time and groups of LANES voices which are
+// all idle are skipped. Within a group, every lane is computed and idle
+// voices keep their old values by blending with the mask, which keeps the
+// loops free of branches.
+namespace tweak::voice {
+
+// 64 bytes of floats, the widest SIMD registers
+inline constexpr auto LANES = size_t(16);
+
+[[nodiscard]] constexpr
+auto padded(size_t voices) -> size_t {
+	return (voices + LANES - 1) / LANES * LANES;
+}
+
+// One value per voice
+struct array {
+	array(size_t voices, float value = 0.0f) : blocks_(padded(voices) / LANES), size_{voices} { fill(value); }
+	[[nodiscard]] auto size() const -> size_t { return size_; }
+	[[nodiscard]] auto padded_size() const -> size_t { return blocks_.size() * LANES; }
+	[[nodiscard]] auto data() -> float* { return blocks_.empty() ? nullptr : blocks_.data()->lanes; }
+	[[nodiscard]] auto data() const -> const float* { return blocks_.empty() ? nullptr : blocks_.data()->lanes; }
+	[[nodiscard]] auto span() -> std::span<float> { return {data(), padded_size()}; }
+	[[nodiscard]] auto span() const -> std::span<const float> { return {data(), padded_size()}; }
+	[[nodiscard]] auto operator[](size_t voice) -> float& { return data()[voice]; }
+	[[nodiscard]] auto operator[](size_t voice) const -> float { return data()[voice]; }
+	auto fill(float value) -> void { std::fill_n(data(), padded_size(), value); }
+private:
+	struct alignas(64) block { float lanes[LANES]; };
+	std::vector<block> blocks_;
+	size_t size_;
+};
+
+// Which voices are playing, as a word per voice with every bit set for a
+// playing voice, so the kernels can blend with bitwise operations
+struct mask {
+	mask(size_t voices) : lanes_(padded(voices), 0), size_{voices} {}
+	[[nodiscard]] auto size() const -> size_t { return size_; }
+	[[nodiscard]] auto padded_size() const -> size_t { return lanes_.size(); }
+	[[nodiscard]] auto test(size_t voice) const -> bool { return lanes_[voice] != 0; }
+	[[nodiscard]] auto lanes() const -> const std::uint32_t* { return lanes_.data(); }
+	auto set(size_t voice, bool active) -> void { lanes_[voice] = active ? ~std::uint32_t(0) : 0; }
+	// Whether any voice in the group of LANES starting at voice `first` is playing
+	[[nodiscard]] auto any(size_t first) const -> bool {
+		auto bits = std::uint32_t(0);
+		for (auto v = first; v < first + LANES; v++) { bits |= lanes_[v]; }
+		return bits != 0;
+	}
+	[[nodiscard]] auto count() const -> size_t { return size_t(std::count_if(lanes_.begin(), lanes_.end(), [](std::uint32_t on) { return on != 0; })); }
+private:
+	std::vector<std::uint32_t> lanes_;
+	size_t size_;
+};
+
+namespace detail {
+
+// a where on is set, b where it isn't
+[[nodiscard]] inline
+auto select(std::uint32_t on, float a, float b) -> float {
+	return std::bit_cast<float>((std::bit_cast<std::uint32_t>(a) & on) | (std::bit_cast<std::uint32_t>(b) & ~on));
+}
+
+} // detail
+
+// out = fn(in) for every playing voice
+template <class Fn>
+auto transform(const mask& active, const array& in, array* out, Fn&& fn) -> void {
+	const auto n    = std::min({active.padded_size(), in.padded_size(), out->padded_size()});
+	const auto* src = in.data();
+	auto* dst       = out->data();
+	const auto* on  = active.lanes();
+	for (size_t first = 0; first < n; first += LANES) {
+		if (!active.any(first)) { continue; }
+		for (auto v = first; v < first + LANES; v++) {
+			dst[v] = detail::select(on[v], fn(src[v]), dst[v]);
+		}
+	}
+}
+
+// The convert functions for every playing voice
+inline auto db_to_linear(const mask& active, const array& db, array* out) -> void {
+	transform(active, db, out, [](float v) { return fastmath::exp2(v * 0.16609640474436811739f); });
+}
+
+inline auto p_to_ff(const mask& active, const array& p, array* out) -> void {
+	transform(active, p, out, [](float v) { return fastmath::exp2(v * (1.0f / 12.0f)); });
+}
+
+inline auto linear_to_speed(const mask& active, const array& linear, array* out) -> void {
+	transform(active, linear, out, [](float v) { return fastmath::exp2(v); });
+}
+
+inline auto clamp(const mask& active, float min, float max, array* values) -> void {
+	transform(active, *values, values, [min, max](float v) { return std::min(std::max(v, min), max); });
+}
+
+template <policy P>
+auto constrain(const mask& active, array* values) -> void {
+	transform(active, *values, values, [](float v) { return P::constrain(v); });
+}
+
+// One pole smoothing of every voice towards its target, per frame
+struct smoother {
+	// coefficient is the fraction of the remaining distance covered each frame
+	smoother(size_t voices, float coefficient) : state_{voices}, coefficient_{coefficient} {}
+	[[nodiscard]] auto state() const -> const array& { return state_; }
+	auto set_coefficient(float coefficient) -> void { coefficient_ = coefficient; }
+	// Jumps straight to value, e.g. when a voice starts
+	auto reset(size_t voice, float value) -> void { state_[voice] = value; }
+	// out gets one row of padded_size() values per frame. Rows for idle
+	// voices are left alone.
+	auto process(const mask& active, const array& target, size_t frames, std::span<float> out) -> void {
+		const auto stride = state_.padded_size();
+		const auto n      = std::min({active.padded_size(), target.padded_size(), stride});
+		if (stride == 0) { return; }
+		frames = std::min(frames, out.size() / stride);
+		const auto* on  = active.lanes();
+		const auto* tgt = target.data();
+		auto* state     = state_.data();
+		const auto c    = coefficient_;
+		for (size_t first = 0; first < n; first += LANES) {
+			if (!active.any(first)) { continue; }
+			for (size_t f = 0; f < frames; f++) {
+				auto* row = out.data() + f * stride;
+				for (auto v = first; v < first + LANES; v++) {
+					const auto s = state[v] + (tgt[v] - state[v]) * c;
+					state[v] = detail::select(on[v], s, state[v]);
+					row[v]   = detail::select(on[v], s, row[v]);
+				}
+			}
+		}
+	}
+private:
+	array state_;
+	float coefficient_;
+};
+
+} // tweak::voice
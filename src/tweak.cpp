@@ -0,0 +1,14 @@
+// Explicit instantiations for tweak::tweak_compiled. Defining TWEAK_EXTERN
+// as nothing turns the extern template declarations at the bottom of each
+// header into the definitions.
+#define TWEAK_EXTERN
+#include <tweak/axis.hpp>
+#include <tweak/spectrum.hpp>
+#include <tweak/tweak.hpp>
+#include <tweak/std/amp.hpp>
+#include <tweak/std/frequency.hpp>
+#include <tweak/std/ms.hpp>
+#include <tweak/std/percentage.hpp>
+#include <tweak/std/pitch.hpp>
+#include <tweak/std/ratio.hpp>
+#include <tweak/std/speed.hpp>
@@ -0,0 +1,418 @@
+module;
+
+#include <tweak/any-param.hpp>
+#include <tweak/axis.hpp>
+#include <tweak/fastmath.hpp>
+#include <tweak/fixed.hpp>
+#include <tweak/macro.hpp>
+#include <tweak/mapped-file.hpp>
+#include <tweak/mod-matrix.hpp>
+#include <tweak/morph.hpp>
+#include <tweak/parallel.hpp>
+#include <tweak/policy.hpp>
+#include <tweak/preset-bank.hpp>
+#include <tweak/preset-library.hpp>
+#include <tweak/preset-text.hpp>
+#include <tweak/random.hpp>
+#include <tweak/snapshot.hpp>
+#include <tweak/spectrum.hpp>
+#include <tweak/tweak.hpp>
+#include <tweak/varispeed.hpp>
+#include <tweak/voice.hpp>
+#include <tweak/std/amp.hpp>
+#include <tweak/std/frequency.hpp>
+#include <tweak/std/ms.hpp>
+#include <tweak/std/percentage.hpp>
+#include <tweak/std/pitch.hpp>
+#include <tweak/std/policies.hpp>
+#include <tweak/std/ratio.hpp>
+#include <tweak/std/speed.hpp>
+
+export module tweak;
+
+export namespace tweak {
+	using tweak::any_param;
+	using tweak::BUILTIN_KINDS;
+	using tweak::constrain;
+	using tweak::decrement;
+	using tweak::drag;
+	using tweak::find_number;
+	using tweak::find_positive_number;
+	using tweak::domain;
+	using tweak::fixed_string;
+	using tweak::formattable_policy;
+	using tweak::increment;
+	using tweak::kind_index;
+	using tweak::kind_of;
+	using tweak::label;
+	using tweak::make_user_policy;
+	using tweak::mapped_file;
+	using tweak::MAX_USER_KINDS;
+	using tweak::mod_matrix;
+	using tweak::parallel_for;
+	using tweak::param_kind;
+	using tweak::policy;
+	using tweak::register_policy;
+	using tweak::snap_value;
+	using tweak::steps;
+	using tweak::thread_pool;
+	using tweak::to_string;
+	using tweak::user_policy;
+	using tweak::visit;
+} // tweak
+
+export namespace tweak::batch {
+	using tweak::batch::constrain;
+	using tweak::batch::decrement;
+	using tweak::batch::drag;
+	using tweak::batch::for_each;
+	using tweak::batch::for_each_grouped;
+	using tweak::batch::for_each_user;
+	using tweak::batch::from_normalized;
+	using tweak::batch::increment;
+	using tweak::batch::stepify;
+	using tweak::batch::to_label;
+	using tweak::batch::to_normalized;
+} // tweak::batch
+
+export namespace tweak::const_math {
+	using tweak::const_math::abs;
+	using tweak::const_math::atan;
+	using tweak::const_math::atan2;
+	using tweak::const_math::cos;
+	using tweak::const_math::cosh;
+	using tweak::const_math::cube;
+	using tweak::const_math::exp;
+	using tweak::const_math::exp2;
+	using tweak::const_math::floor;
+	using tweak::const_math::isfinite;
+	using tweak::const_math::log;
+	using tweak::const_math::pow;
+	using tweak::const_math::sin;
+	using tweak::const_math::sinh;
+	using tweak::const_math::sqrt;
+	using tweak::const_math::square;
+} // tweak::const_math
+
+export namespace tweak::math {
+	using tweak::math::inverse_lerp;
+	using tweak::math::lerp;
+	using tweak::math::stepify;
+} // tweak::math
+
+export namespace tweak::fastmath {
+	using tweak::fastmath::coarse;
+	using tweak::fastmath::coarse_t;
+	using tweak::fastmath::exp;
+	using tweak::fastmath::exp2;
+	using tweak::fastmath::full;
+	using tweak::fastmath::full_t;
+	using tweak::fastmath::LN2;
+	using tweak::fastmath::log;
+	using tweak::fastmath::LOG2E;
+	using tweak::fastmath::log2;
+	using tweak::fastmath::medium;
+	using tweak::fastmath::medium_t;
+	using tweak::fastmath::tier;
+} // tweak::fastmath
+
+export namespace tweak::fixed {
+	using tweak::fixed::constrain;
+	using tweak::fixed::db_to_linear;
+	using tweak::fixed::DB_SCALE;
+	using tweak::fixed::ff_to_p;
+	using tweak::fixed::FRACTION_BITS;
+	using tweak::fixed::frequency_to_pitch;
+	using tweak::fixed::GAIN_SCALE;
+	using tweak::fixed::HZ_SCALE;
+	using tweak::fixed::inverse_lerp;
+	using tweak::fixed::lerp;
+	using tweak::fixed::linear_to_db;
+	using tweak::fixed::p_to_ff;
+	using tweak::fixed::PITCH_SCALE;
+	using tweak::fixed::pitch_to_frequency;
+	using tweak::fixed::q15;
+	using tweak::fixed::q31;
+	using tweak::fixed::q_type;
+	using tweak::fixed::stepify;
+	using tweak::fixed::TABLE_BITS;
+	using tweak::fixed::TABLE_SIZE;
+	using tweak::fixed::to_fixed;
+	using tweak::fixed::to_float;
+} // tweak::fixed
+
+export namespace tweak::convert {
+	using tweak::convert::bi_to_uni;
+	using tweak::convert::db_to_linear;
+	using tweak::convert::ff_to_p;
+	using tweak::convert::filter_hz_to_linear;
+	using tweak::convert::frequency_to_pitch;
+	using tweak::convert::linear_to_db;
+	using tweak::convert::linear_to_filter_hz;
+	using tweak::convert::linear_to_ratio;
+	using tweak::convert::linear_to_speed;
+	using tweak::convert::p_to_ff;
+	using tweak::convert::pitch_to_frequency;
+	using tweak::convert::ratio_to_linear;
+	using tweak::convert::speed_to_linear;
+	using tweak::convert::uni_to_bi;
+} // tweak::convert
+
+export namespace tweak::lut {
+	using tweak::lut::exp2;
+	using tweak::lut::log2;
+} // tweak::lut
+
+export namespace tweak::preset {
+	using tweak::preset::bank_view;
+	using tweak::preset::bank_writer;
+	using tweak::preset::dequantize;
+	using tweak::preset::entry;
+	using tweak::preset::field;
+	using tweak::preset::fd_sink;
+	using tweak::preset::fd_source;
+	using tweak::preset::format_value;
+	using tweak::preset::library;
+	using tweak::preset::line;
+	using tweak::preset::memory_source;
+	using tweak::preset::parse_value;
+	using tweak::preset::preset_view;
+	using tweak::preset::quantize;
+	using tweak::preset::scan_stats;
+	using tweak::preset::string_sink;
+	using tweak::preset::text_reader;
+	using tweak::preset::text_writer;
+} // tweak::preset
+
+export namespace tweak::macro {
+	using tweak::macro::mapping;
+	using tweak::macro::TABLE_SIZE;
+	using tweak::macro::target;
+} // tweak::macro
+
+export namespace tweak::morph {
+	using tweak::morph::engine;
+} // tweak::morph
+
+export namespace tweak::parse {
+	using tweak::parse::find_number;
+	using tweak::parse::iequals;
+	using tweak::parse::number;
+	using tweak::parse::number_at;
+} // tweak::parse
+
+export namespace tweak::axis {
+	using tweak::axis::cache;
+	using tweak::axis::db;
+	using tweak::axis::frequency;
+	using tweak::axis::LABEL_SPACING;
+	using tweak::axis::MINOR_SPACING;
+	using tweak::axis::ms;
+	using tweak::axis::nice_step;
+	using tweak::axis::range;
+	using tweak::axis::speed;
+	using tweak::axis::tick;
+} // tweak::axis
+
+export namespace tweak::random {
+	using tweak::random::counter_rng;
+	using tweak::random::GOLDEN_GAMMA;
+	using tweak::random::mix;
+	using tweak::random::mutate;
+	using tweak::random::randomize;
+	using tweak::random::to_unit;
+} // tweak::random
+
+export namespace tweak::snapshot {
+	using tweak::snapshot::BLOCK_SIZE;
+	using tweak::snapshot::capture;
+	using tweak::snapshot::change;
+	using tweak::snapshot::diff;
+	using tweak::snapshot::differs;
+	using tweak::snapshot::history;
+	using tweak::snapshot::run;
+} // tweak::snapshot
+
+export namespace tweak::varispeed {
+	using tweak::varispeed::accumulator;
+	using tweak::varispeed::FRACTION_BITS;
+	using tweak::varispeed::from_fixed;
+	using tweak::varispeed::generator;
+	using tweak::varispeed::ONE;
+	using tweak::varispeed::to_fixed;
+} // tweak::varispeed
+
+export namespace tweak::voice {
+	using tweak::voice::array;
+	using tweak::voice::clamp;
+	using tweak::voice::constrain;
+	using tweak::voice::db_to_linear;
+	using tweak::voice::LANES;
+	using tweak::voice::linear_to_speed;
+	using tweak::voice::mask;
+	using tweak::voice::p_to_ff;
+	using tweak::voice::padded;
+	using tweak::voice::smoother;
+	using tweak::voice::transform;
+} // tweak::voice
+
+export namespace tweak::spectrum {
+	using tweak::spectrum::bin_map;
+	using tweak::spectrum::key;
+	using tweak::spectrum::magnitude_to_db;
+} // tweak::spectrum
+
+export namespace tweak::std_::amp {
+	using tweak::std_::amp::constrain;
+	using tweak::std_::amp::db_to_label;
+	using tweak::std_::amp::db_to_string;
+	using tweak::std_::amp::db_value;
+	using tweak::std_::amp::db_value_from_string;
+	using tweak::std_::amp::decrement;
+	using tweak::std_::amp::drag;
+	using tweak::std_::amp::from_string;
+	using tweak::std_::amp::increment;
+	using tweak::std_::amp::MAX_DB;
+	using tweak::std_::amp::MAX_LINEAR;
+	using tweak::std_::amp::MIN_DB;
+	using tweak::std_::amp::MIN_LINEAR;
+	using tweak::std_::amp::SILENT;
+	using tweak::std_::amp::stepify;
+	using tweak::std_::amp::to_label;
+	using tweak::std_::amp::to_string;
+} // tweak::std_::amp
+
+export namespace tweak::std_::frequency {
+	using tweak::std_::frequency::constrain;
+	using tweak::std_::frequency::decrement;
+	using tweak::std_::frequency::drag;
+	using tweak::std_::frequency::from_linear;
+	using tweak::std_::frequency::from_pitch;
+	using tweak::std_::frequency::from_string;
+	using tweak::std_::frequency::increment;
+	using tweak::std_::frequency::MAX;
+	using tweak::std_::frequency::MIN;
+	using tweak::std_::frequency::stepify;
+	using tweak::std_::frequency::to_label;
+	using tweak::std_::frequency::to_linear;
+	using tweak::std_::frequency::to_pitch;
+	using tweak::std_::frequency::to_string;
+} // tweak::std_::frequency
+
+export namespace tweak::std_::ms {
+	using tweak::std_::ms::constrain;
+	using tweak::std_::ms::decrement;
+	using tweak::std_::ms::drag;
+	using tweak::std_::ms::from_beats;
+	using tweak::std_::ms::from_samples;
+	using tweak::std_::ms::from_string;
+	using tweak::std_::ms::increment;
+	using tweak::std_::ms::MAX;
+	using tweak::std_::ms::MIN_NONZERO;
+	using tweak::std_::ms::stepify;
+	using tweak::std_::ms::to_beats;
+	using tweak::std_::ms::to_label;
+	using tweak::std_::ms::to_samples;
+	using tweak::std_::ms::to_string;
+	using tweak::std_::ms::ZERO;
+} // tweak::std_::ms
+
+export namespace tweak::std_::percentage {
+	using tweak::std_::percentage::constrain;
+	using tweak::std_::percentage::decrement;
+	using tweak::std_::percentage::drag;
+	using tweak::std_::percentage::from_string;
+	using tweak::std_::percentage::increment;
+	using tweak::std_::percentage::stepify;
+	using tweak::std_::percentage::to_label;
+	using tweak::std_::percentage::to_string;
+} // tweak::std_::percentage
+
+export namespace tweak::std_::percentage::bipolar {
+	using tweak::std_::percentage::bipolar::constrain;
+	using tweak::std_::percentage::bipolar::decrement;
+	using tweak::std_::percentage::bipolar::drag;
+	using tweak::std_::percentage::bipolar::increment;
+	using tweak::std_::percentage::bipolar::stepify;
+} // tweak::std_::percentage::bipolar
+
+export namespace tweak::std_::pitch {
+	using tweak::std_::pitch::constrain;
+	using tweak::std_::pitch::decrement;
+	using tweak::std_::pitch::drag;
+	using tweak::std_::pitch::from_string;
+	using tweak::std_::pitch::increment;
+	using tweak::std_::pitch::MAX;
+	using tweak::std_::pitch::MIN;
+	using tweak::std_::pitch::note_at;
+	using tweak::std_::pitch::offset_to_label;
+	using tweak::std_::pitch::offset_to_string;
+	using tweak::std_::pitch::scale;
+	using tweak::std_::pitch::stepify;
+	using tweak::std_::pitch::to_label;
+	using tweak::std_::pitch::to_string;
+} // tweak::std_::pitch
+
+export namespace tweak::std_::pitch::scales {
+	using tweak::std_::pitch::scales::CHROMATIC;
+	using tweak::std_::pitch::scales::HARMONIC_MINOR;
+	using tweak::std_::pitch::scales::MAJOR;
+	using tweak::std_::pitch::scales::MAJOR_PENTATONIC;
+	using tweak::std_::pitch::scales::MINOR_PENTATONIC;
+	using tweak::std_::pitch::scales::NATURAL_MINOR;
+} // tweak::std_::pitch::scales
+
+export namespace tweak::std_::policies {
+	using tweak::std_::policies::amp;
+	using tweak::std_::policies::bipolar_percentage;
+	using tweak::std_::policies::frequency;
+	using tweak::std_::policies::ms;
+	using tweak::std_::policies::percentage;
+	using tweak::std_::policies::pitch;
+	using tweak::std_::policies::ratio;
+	using tweak::std_::policies::speed;
+} // tweak::std_::policies
+
+export namespace tweak::std_::ratio {
+	using tweak::std_::ratio::constrain;
+	using tweak::std_::ratio::decrement;
+	using tweak::std_::ratio::drag;
+	using tweak::std_::ratio::from_linear;
+	using tweak::std_::ratio::from_string;
+	using tweak::std_::ratio::increment;
+	using tweak::std_::ratio::INF;
+	using tweak::std_::ratio::LOG2_MAX;
+	using tweak::std_::ratio::MAX;
+	using tweak::std_::ratio::MIN;
+	using tweak::std_::ratio::stepify;
+	using tweak::std_::ratio::to_label;
+	using tweak::std_::ratio::to_linear;
+	using tweak::std_::ratio::to_string;
+} // tweak::std_::ratio
+
+export namespace tweak::std_::speed {
+	using tweak::std_::speed::constrain;
+	using tweak::std_::speed::decrement;
+	using tweak::std_::speed::DOUBLE;
+	using tweak::std_::speed::drag;
+	using tweak::std_::speed::EIGHTH;
+	using tweak::std_::speed::find_ratio;
+	using tweak::std_::speed::FREEZE;
+	using tweak::std_::speed::from_string;
+	using tweak::std_::speed::HALF;
+	using tweak::std_::speed::increment;
+	using tweak::std_::speed::MAX;
+	using tweak::std_::speed::MIN;
+	using tweak::std_::speed::NORMAL;
+	using tweak::std_::speed::parse;
+	using tweak::std_::speed::parsed;
+	using tweak::std_::speed::QUARTER;
+	using tweak::std_::speed::ratio;
+	using tweak::std_::speed::SIXTEENTH;
+	using tweak::std_::speed::stepify;
+	using tweak::std_::speed::THIRTYSECOND;
+	using tweak::std_::speed::to_label;
+	using tweak::std_::speed::to_string;
+	using tweak::std_::speed::token;
+	using tweak::std_::speed::TRIPLE;
+} // tweak::std_::speed
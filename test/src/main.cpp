@@ -1,12 +1,35 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include "doctest.h"
+#include <atomic>
+#include <tweak/any-param.hpp>
+#include <tweak/axis.hpp>
 #include <tweak/convert.hpp>
+#include <tweak/fastmath.hpp>
+#include <tweak/fixed.hpp>
+#include <tweak/macro.hpp>
+#include <tweak/mapped-file.hpp>
 #include <tweak/math.hpp>
+#include <tweak/mod-matrix.hpp>
+#include <tweak/morph.hpp>
+#include <tweak/parallel.hpp>
+#include <tweak/policy.hpp>
+#include <tweak/preset-bank.hpp>
+#include <tweak/preset-library.hpp>
+#include <tweak/preset-text.hpp>
+#include <tweak/random.hpp>
+#include <tweak/snapshot.hpp>
 #include <tweak/tweak.hpp>
+#include <tweak/varispeed.hpp>
+#include <tweak/voice.hpp>
 #include <tweak/std/amp.hpp>
+#include <tweak/std/frequency.hpp>
 #include <tweak/std/ms.hpp>
 #include <tweak/std/percentage.hpp>
+#include <tweak/std/pitch.hpp>
+#include <tweak/std/policies.hpp>
+#include <tweak/std/ratio.hpp>
 #include <tweak/std/speed.hpp>
+#include <tweak/spectrum.hpp>
 
 TEST_CASE("non-finite conversion values") {
 	REQUIRE(tweak::convert::db_to_linear(std::numeric_limits<float>::infinity()) == std::numeric_limits<float>::infinity());
@@ -18,3 +41,1036 @@ TEST_CASE("non-finite conversion values") {
 TEST_CASE("std speed compile") {
 	REQUIRE(tweak::std_::speed::from_string("2.0").value() == 2.0f);
 }
+
+template <class T>
+concept label_appendable = requires (tweak::label l, T v) { l.append(v); };
+
+TEST_CASE("non-allocating formatting matches to_string") {
+	REQUIRE(tweak::std_::amp::to_label(1.0f) == "0 dB");
+	REQUIRE(tweak::std_::amp::to_string(0.0f) == "Silent");
+	REQUIRE(tweak::std_::ms::to_label(12.5f) == "12.5 ms");
+	REQUIRE(tweak::std_::speed::to_label(0.0625f) == "1/16");
+	REQUIRE(tweak::std_::speed::to_string(2.0f) == "Double");
+	REQUIRE(tweak::label{"x"}.append('=').append(std::uint8_t(7)).append(-3) == "x=7-3");
+	static_assert(!label_appendable<bool>);
+	static_assert(!label_appendable<char32_t>);
+}
+
+TEST_CASE("axis ticks") {
+	auto db = tweak::axis::cache<tweak::axis::db>{};
+	const auto ticks = db.get(-60.0f, 12.0f, 300);
+	REQUIRE(!ticks.empty());
+	REQUIRE(ticks.front().position == doctest::Approx(0.0f));
+	REQUIRE(ticks.front().text == "-60 dB");
+	REQUIRE(ticks.back().position == doctest::Approx(300.0f));
+	REQUIRE(db.get(-60.0f, 12.0f, 300).data() == ticks.data());
+	auto hz = tweak::axis::cache<tweak::axis::frequency>{};
+	const auto hz_ticks = hz.get(20.0f, 20000.0f, 800);
+	REQUIRE(hz_ticks.size() > 3);
+	for (size_t i = 1; i < hz_ticks.size(); i++) {
+		REQUIRE(hz_ticks[i].position > hz_ticks[i - 1].position);
+	}
+	REQUIRE(std::find_if(hz_ticks.begin(), hz_ticks.end(), [](const auto& t) { return t.text == "1 kHz"; }) != hz_ticks.end());
+	auto speed = tweak::axis::cache<tweak::axis::speed>{};
+	const auto speed_ticks = speed.get(0.25f, 4.0f, 400);
+	REQUIRE(speed_ticks.size() == 5);
+	REQUIRE(speed_ticks[2].text == "Normal");
+	REQUIRE(speed_ticks[2].position == doctest::Approx(200.0f));
+}
+
+TEST_CASE("spectrum bin mapping") {
+	auto map = tweak::spectrum::bin_map<float>{};
+	map.configure(8192, 48000.0f, 512);
+	REQUIRE(map.bin_count() == 4097);
+	const auto positions = map.positions();
+	REQUIRE(std::is_sorted(positions.begin(), positions.end()));
+	REQUIRE(positions[1] == doctest::Approx(tweak::convert::filter_hz_to_linear(48000.0f / 8192) * 512));
+	auto bins = std::vector<float>(map.bin_count(), 0.0f);
+	bins[1000] = 1.0f;
+	auto pixels = std::vector<float>(512, -1.0f);
+	map.group_max(bins, pixels);
+	REQUIRE(*std::max_element(pixels.begin(), pixels.end()) == 1.0f);
+	REQUIRE(*std::min_element(pixels.begin(), pixels.end()) == 0.0f);
+	// Short bin buffers stop early rather than reading past the end
+	std::fill(pixels.begin(), pixels.end(), -1.0f);
+	map.group_max(std::span{bins}.first(2049), pixels);
+	REQUIRE(pixels.back() == -1.0f);
+	REQUIRE(*std::max_element(pixels.begin(), pixels.end()) == 1.0f);
+	map.configure(1, 48000.0f, 4);
+	std::fill(pixels.begin(), pixels.end(), -1.0f);
+	map.group_max(std::span{bins}.first(1), pixels);
+	REQUIRE(pixels[0] == -1.0f);
+	auto db = std::vector<float>(3);
+	tweak::spectrum::magnitude_to_db<float>(std::vector{1.0f, 0.1f, 0.0f}, db, -100.0f);
+	REQUIRE(db[0] == doctest::Approx(0.0f));
+	REQUIRE(db[1] == doctest::Approx(-20.0f));
+	REQUIRE(db[2] == doctest::Approx(-100.0f).epsilon(0.001));
+}
+
+TEST_CASE("std amp db_value") {
+	namespace amp = tweak::std_::amp;
+	REQUIRE(amp::constrain(tweak::convert::db_to_linear(-70.0f)) == amp::SILENT);
+	REQUIRE(amp::constrain(tweak::convert::db_to_linear(20.0f)) == amp::MAX_LINEAR<float>);
+	REQUIRE(amp::constrain(0.5f) == 0.5f);
+	auto v = amp::db_value<float>{};
+	REQUIRE(v.is_silent());
+	REQUIRE(float(v) == amp::SILENT);
+	v = amp::increment(v, false);
+	REQUIRE(v.db() == -60.0f);
+	REQUIRE(v.linear() == doctest::Approx(amp::increment(amp::SILENT, false)));
+	for (int i = 0; i < 75; i++) { v = amp::constrain(amp::increment(v, false)); }
+	REQUIRE(v.db() == 12.0f);
+	REQUIRE(amp::to_string(amp::decrement(v, true)) == "11.9 dB");
+	REQUIRE(amp::to_string(amp::constrain(amp::drag(v, -500, false))) == "Silent");
+	REQUIRE(amp::db_value<float>{1.0f}.db() == doctest::Approx(0.0f));
+	REQUIRE(amp::db_value_from_string("-6 dB")->db() == -6.0f);
+}
+
+TEST_CASE("std speed labels") {
+	namespace speed = tweak::std_::speed;
+	REQUIRE(speed::constrain(1e-12f) == speed::FREEZE);
+	REQUIRE(speed::increment(speed::FREEZE, false) == speed::MIN<float>);
+	REQUIRE(speed::to_string(speed::FREEZE) == "Freeze");
+	REQUIRE(speed::to_string(1.0005f) == "Normal");
+	REQUIRE(speed::to_string(1.0f / 3.0f) == "1/3");
+	REQUIRE(speed::to_string(1.0f / 48.0f) == "1/48");
+	REQUIRE(speed::to_string(1.0f / 128.0f) == "1/128");
+	REQUIRE(speed::to_string(0.3f) == "x0.3");
+	REQUIRE(speed::to_string(3.0f) == "Triple");
+	REQUIRE(speed::to_string(4.0f) == "x4");
+	const auto values = std::vector{0.0625f, 2.0f, 1.5f};
+	auto labels = std::vector<tweak::label>(values.size());
+	speed::to_label<float>(values, labels);
+	REQUIRE(labels[0] == "1/16");
+	REQUIRE(labels[1] == "Double");
+	REQUIRE(labels[2] == "x1.5");
+}
+
+TEST_CASE("std speed parsing") {
+	namespace speed = tweak::std_::speed;
+	REQUIRE(speed::from_string("  double ").value() == speed::DOUBLE);
+	REQUIRE(speed::from_string("NoRmAl speed").value() == speed::NORMAL);
+	REQUIRE(speed::from_string("triple or freeze").value() == speed::FREEZE);
+	REQUIRE(speed::from_string("1/16").value() == speed::SIXTEENTH);
+	REQUIRE(speed::from_string("x2.5").value() == 2.5f);
+	REQUIRE(speed::from_string("-3").value() == -3.0f);
+	REQUIRE(speed::from_string(".5").value() == 0.5f);
+	REQUIRE(!speed::from_string("fast"));
+	REQUIRE(!speed::from_string(""));
+	REQUIRE(speed::parse("50 %")->kind == speed::token::percentage);
+	REQUIRE(speed::parse("50 %")->value == 0.5f);
+	REQUIRE(speed::parse("X3")->kind == speed::token::multiplier);
+	REQUIRE(speed::parse("speed 1/8 or 4")->kind == speed::token::fraction);
+	REQUIRE(speed::parse("Triple")->kind == speed::token::triple);
+	REQUIRE(speed::parse("2")->kind == speed::token::number);
+}
+
+TEST_CASE("find number") {
+	REQUIRE(tweak::find_number<float>("gain -6.5 dB").value() == -6.5f);
+	REQUIRE(tweak::find_number<float>("- 3").value() == -3.0f);
+	REQUIRE(tweak::find_number<float>("1.2.3").value() == 1.2f);
+	REQUIRE(tweak::find_number<int>("-12 st").value() == -12);
+	REQUIRE(tweak::find_positive_number<float>("-40 ms").value() == 40.0f);
+	REQUIRE(!tweak::find_number<float>("none"));
+	REQUIRE(tweak::to_string(0.5f) == "0.5");
+	REQUIRE(tweak::std_::percentage::to_string(0.25f) == "25%");
+	REQUIRE(tweak::std_::percentage::from_string("50%").value() == 0.5f);
+}
+
+TEST_CASE("std frequency") {
+	namespace frequency = tweak::std_::frequency;
+	REQUIRE(tweak::convert::pitch_to_frequency(69.0f) == doctest::Approx(440.0f));
+	REQUIRE(frequency::to_pitch(440.0f) == doctest::Approx(69.0f));
+	REQUIRE(frequency::from_pitch(57.0f) == doctest::Approx(220.0f));
+	REQUIRE(frequency::to_linear(1000.0f) == doctest::Approx(tweak::convert::filter_hz_to_linear(1000.0f)));
+	REQUIRE(frequency::from_linear(0.5f) == doctest::Approx(tweak::convert::linear_to_filter_hz(0.5f)).epsilon(0.0001));
+	REQUIRE(frequency::increment(440.0f, false) == doctest::Approx(466.1638f));
+	REQUIRE(frequency::drag(440.0f, -60, false) == doctest::Approx(220.0f));
+	REQUIRE(frequency::constrain(1e6f) == frequency::MAX<float>);
+	REQUIRE(frequency::to_string(440.0f) == "440 Hz");
+	REQUIRE(frequency::to_string(55.24f) == "55.2 Hz");
+	REQUIRE(frequency::to_string(1200.0f) == "1.2 kHz");
+	REQUIRE(frequency::to_string(999.8f) == "1 kHz");
+	REQUIRE(frequency::from_string("440hz").value() == 440.0f);
+	REQUIRE(frequency::from_string("1.2 kHz").value() == doctest::Approx(1200.0f));
+	REQUIRE(frequency::from_string("1k25").value() == doctest::Approx(1250.0f));
+	REQUIRE(frequency::from_string("2K").value() == 2000.0f);
+	REQUIRE(!frequency::from_string("off"));
+	auto hz = std::vector<float>(3);
+	frequency::from_linear<float>(std::vector{0.0f, 0.5f, 2.0f}, hz);
+	REQUIRE(hz[0] == doctest::Approx(frequency::MIN<float>));
+	REQUIRE(hz[2] == frequency::MAX<float>);
+}
+
+TEST_CASE("std pitch") {
+	namespace pitch = tweak::std_::pitch;
+	REQUIRE(pitch::increment(60.0f, false) == 61.0f);
+	REQUIRE(pitch::increment(60.0f, true) == doctest::Approx(60.01f));
+	REQUIRE(pitch::to_string(60.0f) == "C4");
+	REQUIRE(pitch::to_string(61.0f) == "C#4");
+	REQUIRE(pitch::to_string(69.12f) == "A4 +12 ct");
+	REQUIRE(pitch::to_string(68.88f) == "A4 -12 ct");
+	REQUIRE(pitch::to_string(0.0f) == "C-1");
+	REQUIRE(pitch::offset_to_string(7.0f) == "+7 st");
+	REQUIRE(pitch::offset_to_string(-0.35f) == "-35 ct");
+	REQUIRE(pitch::offset_to_string(-7.35f) == "-7 st -35 ct");
+	REQUIRE(pitch::from_string("C#4").value() == 61.0f);
+	REQUIRE(pitch::from_string("db3").value() == 49.0f);
+	REQUIRE(pitch::from_string("C-1").value() == 0.0f);
+	REQUIRE(pitch::from_string("A4 -12 ct").value() == doctest::Approx(68.88f));
+	REQUIRE(pitch::from_string("+7 st").value() == 7.0f);
+	REQUIRE(pitch::from_string("-35 ct").value() == doctest::Approx(-0.35f));
+	REQUIRE(pitch::from_string(pitch::offset_to_string(-7.35f)).value() == doctest::Approx(-7.35f));
+	REQUIRE(!pitch::from_string("hello"));
+	const auto major = pitch::scale<float>{pitch::scales::MAJOR, 2.0f};
+	REQUIRE(major.quantize(62.4f) == 62.0f);
+	REQUIRE(major.quantize(63.4f) == 64.0f);
+	REQUIRE(major.quantize(60.9f) == 61.0f);
+	REQUIRE(major.quantize(-0.6f) == -1.0f);
+	const auto quarter_tones = pitch::scale<float>{std::array{0.0f, 0.5f, 3.5f}};
+	REQUIRE(quarter_tones.quantize(12.3f) == 12.5f);
+	REQUIRE(quarter_tones.quantize(14.1f) == 15.5f);
+	REQUIRE(quarter_tones.quantize(11.0f) == 12.0f);
+	// A degree which wraps to the period in float is folded back to 0
+	const auto wrapped = pitch::scale<float>{std::array{0.0f, -1e-7f}};
+	REQUIRE(wrapped.quantize(5.3f) == 0.0f);
+	REQUIRE(wrapped.quantize(6.3f) == 12.0f);
+	// Degrees closer than a cell share cells and are searched
+	auto dense_degrees = std::vector<float>{0.0f, 7.0f};
+	for (auto i = 0; i < 10; i++) { dense_degrees.push_back(3.0f + float(i) * 1e-6f); }
+	const auto dense = pitch::scale<float>{dense_degrees};
+	REQUIRE(dense.quantize(1.4f) == 0.0f);
+	REQUIRE(dense.quantize(1.6f) == 3.0f);
+	REQUIRE(dense.quantize(3.0000051f) == doctest::Approx(3.000005f).epsilon(1e-7));
+	REQUIRE(dense.quantize(3.0000098f) == doctest::Approx(3.000009f).epsilon(1e-7));
+	REQUIRE(dense.quantize(5.1f) == 7.0f);
+	for (auto v = -20.0f; v < 20.0f; v += 0.013f) {
+		const auto q = dense.quantize(v);
+		auto best = 1e9f;
+		for (const auto d : dense_degrees) {
+			for (auto k = -3; k <= 3; k++) { best = std::min(best, std::abs(d + 12.0f * float(k) - v)); }
+		}
+		REQUIRE(std::abs(q - v) == doctest::Approx(best).epsilon(1e-4));
+	}
+	auto voices = std::vector<float>{60.2f, 61.6f, 66.4f};
+	major.quantize(voices, voices);
+	REQUIRE(voices == std::vector<float>{61.0f, 62.0f, 66.0f});
+}
+
+TEST_CASE("std ms") {
+	namespace ms = tweak::std_::ms;
+	REQUIRE(ms::increment(0.0f, false) == ms::MIN_NONZERO);
+	REQUIRE(ms::increment(100.0f, false) == doctest::Approx(109.05077f));
+	REQUIRE(ms::decrement(ms::increment(100.0f, true), true) == doctest::Approx(100.0f));
+	REQUIRE(ms::drag(100.0f, 40 * 5, false) == doctest::Approx(3200.0f));
+	REQUIRE(ms::decrement(0.05f, false) == ms::ZERO);
+	REQUIRE(ms::constrain(1e9f) == ms::MAX);
+	REQUIRE(ms::to_string(12.5f) == "12.5 ms");
+	REQUIRE(ms::to_string(1500.0f) == "1.5 s");
+	REQUIRE(ms::from_string("12.5 ms").value() == 12.5f);
+	REQUIRE(ms::from_string("1.5s").value() == 1500.0f);
+	REQUIRE(ms::from_string("250").value() == 250.0f);
+	REQUIRE(!ms::from_string("none"));
+	REQUIRE(ms::from_string("2 Seconds").value() == 2000.0f);
+	REQUIRE(ms::from_string("3 secs").value() == 3000.0f);
+	REQUIRE(ms::from_string("40MS").value() == 40.0f);
+	REQUIRE(!ms::from_string("5 samples"));
+	REQUIRE(!ms::from_string("5 smth"));
+	REQUIRE(ms::to_samples(10.0f, 48000.0f) == 480.0f);
+	REQUIRE(ms::from_samples(480.0f, 48000.0f) == 10.0f);
+	REQUIRE(ms::to_beats(500.0f, 120.0f) == 1.0f);
+	REQUIRE(ms::from_beats(0.25f, 120.0f) == 125.0f);
+	auto counts = std::vector<std::int64_t>(2);
+	ms::to_samples<float>(std::vector{1.0f, 2.51f}, 44100.0f, counts);
+	REQUIRE(counts == std::vector<std::int64_t>{44, 111});
+}
+
+TEST_CASE("std ratio") {
+	namespace ratio = tweak::std_::ratio;
+	REQUIRE(tweak::convert::linear_to_ratio(0.5f) == doctest::Approx(3.1622777f));
+	REQUIRE(ratio::from_linear(0.5f) == doctest::Approx(3.1622777f));
+	REQUIRE(ratio::to_linear(ratio::from_linear(0.3f)) == doctest::Approx(0.3f));
+	REQUIRE(ratio::from_linear(1.0f) == ratio::INF);
+	REQUIRE(ratio::constrain(0.5f) == ratio::MIN);
+	REQUIRE(ratio::constrain(200.0f) == ratio::INF);
+	REQUIRE(ratio::increment(ratio::MAX, false) == ratio::INF);
+	REQUIRE(ratio::decrement(ratio::INF, false) < ratio::MAX);
+	REQUIRE(ratio::decrement(ratio::increment(4.0f, true), true) == doctest::Approx(4.0f));
+	REQUIRE(ratio::to_string(4.0f) == "4:1");
+	REQUIRE(ratio::to_string(2.54f) == "2.5:1");
+	REQUIRE(ratio::to_string(ratio::INF) == "inf:1");
+	REQUIRE(ratio::from_string("4:1").value() == 4.0f);
+	REQUIRE(ratio::from_string("2.5").value() == 2.5f);
+	REQUIRE(ratio::from_string("inf:1").value() == ratio::INF);
+	REQUIRE(ratio::from_string("\xE2\x88\x9E:1").value() == ratio::INF);
+	REQUIRE(!ratio::from_string("none"));
+	auto out = std::vector<float>(3);
+	ratio::from_linear<float>(std::vector{0.0f, 0.5f, 1.0f}, out);
+	REQUIRE(out[0] == 1.0f);
+	REQUIRE(out[1] == doctest::Approx(3.1622777f));
+	REQUIRE(out[2] == ratio::INF);
+}
+
+template <tweak::policy P>
+auto round_trips(typename P::value_type v) -> bool {
+	const auto n = P::to_normalized(v);
+	return n >= 0 && n <= 1 && std::abs(P::from_normalized(n) - v) <= std::abs(v) * 1e-3f;
+}
+
+TEST_CASE("std policies") {
+	namespace policies = tweak::std_::policies;
+	static_assert(!tweak::policy<float>);
+	REQUIRE(round_trips<policies::amp<>>(0.5f));
+	REQUIRE(round_trips<policies::frequency<>>(440.0f));
+	REQUIRE(round_trips<policies::ms<>>(250.0f));
+	REQUIRE(round_trips<policies::percentage<>>(0.25f));
+	REQUIRE(round_trips<policies::bipolar_percentage<>>(-0.5f));
+	REQUIRE(round_trips<policies::pitch<>>(60.0f));
+	REQUIRE(round_trips<policies::ratio<>>(4.0f));
+	REQUIRE(round_trips<policies::speed<>>(2.0f));
+	REQUIRE(policies::amp<>::to_normalized(policies::amp<>::MIN) == 0.0f);
+	REQUIRE(policies::speed<>::stepify(0.25002f) == 0.25f);
+	REQUIRE(policies::bipolar_percentage<>::increment(-1.0f, false) == doctest::Approx(-0.99f));
+	auto values = std::vector<float>{-0.5f, 0.5f, 1.5f};
+	tweak::batch::constrain<policies::percentage<>>(values, values);
+	REQUIRE(values == std::vector<float>{0.0f, 0.5f, 1.0f});
+	tweak::batch::increment<policies::pitch<>>(values, false, values);
+	REQUIRE(values == std::vector<float>{1.0f, 1.5f, 2.0f});
+	auto labels = std::vector<tweak::label>(2);
+	tweak::batch::to_label<policies::ms<>>(std::vector{12.5f, 1500.0f}, labels);
+	REQUIRE(labels[0] == "12.5 ms");
+	REQUIRE(labels[1] == "1.5 s");
+}
+
+struct gain_policy {
+	using value_type = float;
+	static constexpr auto MIN     = 0.0f;
+	static constexpr auto MAX     = 2.0f;
+	static constexpr auto DEFAULT = 1.0f;
+	static constexpr auto DOMAIN  = tweak::domain::linear;
+	static constexpr auto STEPS   = tweak::steps{10, 100};
+	static auto constrain(float v) -> float { return std::clamp(v, MIN, MAX); }
+	static auto stepify(float v) -> float { return tweak::math::stepify(v, 0.01f); }
+	static auto increment(float v, bool precise) -> float { return tweak::increment<10, 100>(v, precise); }
+	static auto decrement(float v, bool precise) -> float { return tweak::decrement<10, 100>(v, precise); }
+	static auto drag(float v, int amount, bool precise) -> float { return tweak::drag<float, 10, 100>(v, amount / 5, precise); }
+	static auto to_normalized(float v) -> float { return v / MAX; }
+	static auto from_normalized(float v) -> float { return v * MAX; }
+	static auto to_label(float v) -> tweak::label { return tweak::label{"x"}.append(v); }
+	static auto from_string(std::string_view str) -> std::optional<float> { return tweak::find_number<float>(str); }
+};
+
+TEST_CASE("any_param") {
+	using tweak::param_kind;
+	auto freq = tweak::any_param{param_kind::frequency, 20.0f, 20000.0f, 440.0f};
+	REQUIRE(freq.value() == 440.0f);
+	freq.set(5.0f);
+	REQUIRE(freq.value() == 20.0f);
+	REQUIRE(freq.from_string("1k"));
+	REQUIRE(freq.value() == 1000.0f);
+	REQUIRE(!freq.from_string("none"));
+	REQUIRE(freq.to_label() == "1 kHz");
+	const auto reversed = tweak::any_param{param_kind::percentage, 0.8f, 0.2f, 0.9f};
+	REQUIRE(reversed.min() == 0.2f);
+	REQUIRE(reversed.max() == 0.8f);
+	REQUIRE(reversed.value() == 0.8f);
+	auto pct = tweak::any_param{param_kind::percentage};
+	pct.increment(false);
+	REQUIRE(pct.value() == doctest::Approx(0.01f));
+	const auto gain = tweak::register_policy<gain_policy>();
+	REQUIRE(gain == param_kind::user);
+	REQUIRE(tweak::register_policy<gain_policy>() == gain);
+	auto params = std::vector<tweak::any_param>{
+		{param_kind::pitch}, {*gain}, {param_kind::percentage}, {param_kind::pitch}, {param_kind::amp},
+	};
+	const auto index = tweak::kind_index{params};
+	REQUIRE(index.group(param_kind::pitch).size() == 2);
+	REQUIRE(index.group(param_kind::user).size() == 1);
+	tweak::batch::increment(params, index, false);
+	REQUIRE(params[0].value() == 61.0f);
+	REQUIRE(params[1].value() == doctest::Approx(1.1f));
+	REQUIRE(params[2].value() == doctest::Approx(0.01f));
+	REQUIRE(params[3].value() == 61.0f);
+	REQUIRE(params[4].value() == doctest::Approx(tweak::convert::db_to_linear(1.0f)));
+	auto normalized = std::vector<float>(params.size());
+	tweak::batch::to_normalized(params, index, normalized);
+	REQUIRE(normalized[0] == doctest::Approx(61.0f / 127.0f));
+	REQUIRE(normalized[1] == doctest::Approx(0.55f));
+	auto labels = std::vector<tweak::label>(params.size());
+	tweak::batch::to_label(params, index, labels);
+	REQUIRE(labels[0] == "C#4");
+	REQUIRE(labels[1] == "x1.1");
+}
+
+TEST_CASE("preset bank") {
+	using tweak::param_kind;
+	for (const auto quantized : {false, true}) {
+		auto writer = tweak::preset::bank_writer{quantized};
+		writer.begin_preset("Lead");
+		writer.add(7, param_kind::frequency, 440.0f);
+		writer.add(2, param_kind::pitch, 61.5f);
+		REQUIRE(writer.add(3, param_kind::amp, std::string_view{"-6 dB"}));
+		REQUIRE(!writer.add(4, param_kind::ms, std::string_view{"none"}));
+		REQUIRE(!writer.add(5, param_kind(255), 0.5f));
+		REQUIRE(!writer.add(5, param_kind(255), std::string_view{"0.5"}));
+		writer.add(2, param_kind::pitch, 62.0f);
+		writer.begin_preset("Pad");
+		writer.add(1, param_kind::percentage, 0.25f);
+		const auto bytes = writer.bytes();
+		const auto bank  = tweak::preset::bank_view::open(bytes);
+		REQUIRE(bank);
+		REQUIRE(bank->size() == 2);
+		REQUIRE(bank->quantized() == quantized);
+		REQUIRE(bank->name(1) == "Pad");
+		const auto lead = (*bank)[0];
+		REQUIRE(lead.name() == "Lead");
+		REQUIRE(lead.size() == 3);
+		REQUIRE(lead.id(0) == 2);
+		REQUIRE(lead.find(2)->value == 62.0f);
+		REQUIRE(lead.find(7)->kind == param_kind::frequency);
+		REQUIRE(lead.find(7)->value == doctest::Approx(440.0f).epsilon(0.001));
+		REQUIRE(lead.find(3)->value == doctest::Approx(tweak::convert::db_to_linear(-6.0f)).epsilon(0.001));
+		REQUIRE(!lead.find(4));
+		REQUIRE((*bank)[1].find(1)->value == 0.25f);
+		auto truncated = std::vector<std::byte>(bytes.begin(), bytes.end() - 12);
+		REQUIRE(!tweak::preset::bank_view::open(truncated));
+	}
+	REQUIRE(!tweak::preset::bank_view::open(std::vector<std::byte>(32)));
+	const auto path   = std::filesystem::temp_directory_path() / "tweak-test-bank.twkb";
+	auto writer = tweak::preset::bank_writer{true};
+	writer.add(1, param_kind::speed, 2.0f);
+	REQUIRE(writer.write(path));
+	{
+		const auto file = tweak::mapped_file{path};
+		REQUIRE(file.is_open());
+		const auto bank = tweak::preset::bank_view::open(file.bytes());
+		REQUIRE(bank);
+		REQUIRE((*bank)[0].find(1)->value == 2.0f);
+	}
+	std::filesystem::remove(path);
+}
+
+TEST_CASE("text presets") {
+	using tweak::param_kind;
+	const auto params = std::vector<tweak::any_param>{
+		{param_kind::amp, 0.0f, 4.0f, 0.4f},
+		{param_kind::frequency, 20.0f, 20000.0f, 1234.567f},
+		{param_kind::ms, 0.0f, 60000.0f, 12.3456f},
+		{param_kind::percentage, 0.0f, 1.0f, 0.33333f},
+		{param_kind::bipolar_percentage, -1.0f, 1.0f, -0.12345f},
+		{param_kind::pitch, 0.0f, 127.0f, 61.23456f},
+		{param_kind::ratio, 1.0f, tweak::std_::ratio::INF, tweak::std_::ratio::INF},
+		{param_kind::speed, 0.0f, 32.0f, 0.3333f},
+	};
+	auto text   = std::string{};
+	auto buffer = std::array<char, 32>{};
+	{
+		auto writer = tweak::preset::text_writer{std::span{buffer}, tweak::preset::string_sink{&text}};
+		for (size_t i = 0; i < params.size(); i++) {
+			REQUIRE(writer.write("param" + std::to_string(i), params[i]));
+		}
+	}
+	text += "# comment\n\nbroken line\nhand = 1.2 kHz\r\n";
+	text += "long=" + std::string(40, '1') + "\n";
+	auto reader = tweak::preset::text_reader{std::span{buffer}, tweak::preset::memory_source{text}};
+	for (size_t i = 0; i < params.size(); i++) {
+		const auto line = reader.next();
+		REQUIRE(line);
+		REQUIRE(line->key == "param" + std::to_string(i));
+		const auto kind     = params[i].kind();
+		const auto expected = tweak::visit(kind, [&](const auto& p) { return p.stepify(p.constrain(params[i].value())); });
+		REQUIRE(tweak::preset::parse_value(kind, line->value) == expected);
+	}
+	const auto hand = reader.next();
+	REQUIRE(hand);
+	REQUIRE(hand->key == "hand");
+	REQUIRE(*tweak::preset::parse_value(param_kind::frequency, hand->value) == doctest::Approx(1200.0f).epsilon(0.001));
+	REQUIRE(!reader.next());
+	REQUIRE(reader.skipped() == 2);
+	// An overlong last line without a newline is counted too
+	const auto tail = "a=1\nlong=" + std::string(40, '1');
+	auto tail_reader = tweak::preset::text_reader{std::span{buffer}, tweak::preset::memory_source{tail}};
+	REQUIRE(tail_reader.next());
+	REQUIRE(!tail_reader.next());
+	REQUIRE(tail_reader.skipped() == 1);
+	REQUIRE(!tweak::preset::parse_value(param_kind::ms, "none"));
+}
+
+TEST_CASE("parallel_for") {
+	auto hits = std::vector<std::atomic<int>>(1000);
+	tweak::parallel_for(hits.size(), 4, [&hits](size_t i) { hits[i]++; });
+	REQUIRE(std::all_of(hits.begin(), hits.end(), [](const auto& h) { return h == 1; }));
+	auto pool = tweak::thread_pool{3};
+	REQUIRE(pool.size() == 3);
+	for (auto run = 0; run < 20; run++) {
+		tweak::parallel_for(pool, hits.size(), [&hits](size_t i) { hits[i]++; });
+	}
+	tweak::parallel_for(pool, 2, [&hits](size_t i) { hits[i]++; });
+	REQUIRE(std::all_of(hits.begin() + 2, hits.end(), [](const auto& h) { return h == 21; }));
+	REQUIRE(hits[0] == 22);
+}
+
+TEST_CASE("preset library") {
+	using tweak::param_kind;
+	namespace fs = std::filesystem;
+	const auto dir = fs::temp_directory_path() / "tweak-test-library";
+	fs::remove_all(dir);
+	fs::create_directories(dir / "sub");
+	const auto write = [](const fs::path& path, std::string_view text) {
+		auto file = std::fopen(path.string().c_str(), "wb");
+		std::fwrite(text.data(), 1, text.size(), file);
+		std::fclose(file);
+	};
+	write(dir / "a.tweak", "gain=0.25\nspeed=Double\n");
+	write(dir / "b.tweak", "gain=-3 dB\nspeed=1/2\n");
+	write(dir / "sub" / "c.tweak", "speed=2\nunknown=7\n");
+	write(dir / "ignored.txt", "gain=1\n");
+	auto lib = tweak::preset::library{{{"gain", param_kind::amp}, {"speed", param_kind::speed}}};
+	auto stats = lib.scan(dir, ".tweak", 2);
+	REQUIRE(lib.size() == 3);
+	REQUIRE(stats.parsed == 3);
+	const auto gain  = *lib.find_field("gain");
+	const auto speed = *lib.find_field("speed");
+	REQUIRE(!lib.find_field("unknown"));
+	REQUIRE(std::isnan(lib.value(2, gain)));
+	const auto loud = lib.select(gain, tweak::convert::db_to_linear(-6.0f), tweak::std_::amp::MAX_LINEAR<float>);
+	REQUIRE(loud == std::vector<std::uint32_t>{1});
+	const auto doubled = lib.select_equal(speed, 2.0f);
+	REQUIRE(doubled == std::vector<std::uint32_t>{0, 2});
+	REQUIRE(lib.select(gain, 0.0f, 1.0f, doubled) == std::vector<std::uint32_t>{0});
+	write(dir / "b.tweak", "gain=-12 dB\n");
+	fs::last_write_time(dir / "b.tweak", fs::last_write_time(dir / "b.tweak") + std::chrono::seconds{10});
+	fs::remove(dir / "sub" / "c.tweak");
+	stats = lib.scan(dir, ".tweak");
+	REQUIRE(lib.size() == 2);
+	REQUIRE(stats.parsed == 1);
+	REQUIRE(stats.reused == 1);
+	REQUIRE(stats.removed == 1);
+	REQUIRE(lib.select(gain, tweak::convert::db_to_linear(-6.0f), 4.0f).empty());
+	REQUIRE(lib.value(0, speed) == 2.0f);
+	// A file which can't be opened is read again once it can be, even though
+	// it hasn't been modified. Root can open anything, so this only runs for
+	// other users.
+	write(dir / "locked.tweak", "gain=-12 dB\n");
+	fs::permissions(dir / "locked.tweak", fs::perms::none);
+	if (const auto probe = std::fopen((dir / "locked.tweak").string().c_str(), "rb")) {
+		std::fclose(probe);
+	}
+	else {
+		stats = lib.scan(dir, ".tweak");
+		REQUIRE(stats.failed == 1);
+		const auto locked = lib.size() - 1;
+		REQUIRE(std::isnan(lib.value(locked, gain)));
+		fs::permissions(dir / "locked.tweak", fs::perms::owner_read | fs::perms::owner_write);
+		stats = lib.scan(dir, ".tweak");
+		REQUIRE(stats.parsed == 1);
+		REQUIRE(stats.failed == 0);
+		REQUIRE(lib.value(locked, gain) == lib.value(1, gain));
+	}
+	fs::remove_all(dir);
+}
+
+TEST_CASE("snapshot diff and history") {
+	using tweak::param_kind;
+	auto params = std::vector<tweak::any_param>(200, tweak::any_param{param_kind::pitch});
+	const auto index = tweak::kind_index{params};
+	auto before = std::vector<float>(params.size());
+	tweak::snapshot::capture(params, index, before);
+	params[3].set(60.001f);
+	params[150].set(64.0f);
+	auto after = std::vector<float>(params.size());
+	tweak::snapshot::capture(params, index, after);
+	auto changes = std::vector<tweak::snapshot::change>{};
+	tweak::snapshot::diff(before, after, &changes);
+	REQUIRE(changes.size() == 1);
+	REQUIRE(changes[0].index == 150);
+	REQUIRE(changes[0].before == 60.0f);
+	REQUIRE(changes[0].after == 64.0f);
+	const auto size = size_t(10000);
+	auto state   = std::vector<float>(size, 0.0f);
+	auto history = tweak::snapshot::history{state};
+	auto states  = std::vector<std::vector<float>>{state};
+	REQUIRE(!history.commit(state));
+	for (size_t i = 0; i < 1000; i++) {
+		state[(i * 7919) % size] = float(i);
+		state[(i * 7919 + 1) % size] = float(i) + 0.5f;
+		REQUIRE(history.commit(state));
+		states.push_back(state);
+	}
+	REQUIRE(history.memory() < size * sizeof(float) * 2);
+	for (size_t i = 1000; i > 990; i--) {
+		const auto undone = history.undo();
+		REQUIRE(std::equal(undone.begin(), undone.end(), states[i - 1].begin()));
+	}
+	const auto redone = history.redo();
+	REQUIRE(std::equal(redone.begin(), redone.end(), states[991].begin()));
+	while (history.can_undo()) { (void)history.undo(); }
+	REQUIRE(std::equal(history.state().begin(), history.state().end(), states[0].begin()));
+	state = states[0];
+	state[5] = 1.0f;
+	REQUIRE(history.commit(state));
+	REQUIRE(history.steps() == 1);
+	REQUIRE(!history.can_redo());
+	REQUIRE(history.undo()[5] == 0.0f);
+}
+
+TEST_CASE("morph") {
+	using tweak::param_kind;
+	const auto kinds = std::vector{param_kind::amp, param_kind::speed, param_kind::frequency, param_kind::ms, param_kind::percentage};
+	auto morph = tweak::morph::engine{kinds, 3};
+	REQUIRE(morph.parameters() == 5);
+	REQUIRE(morph.presets() == 3);
+	morph.set_preset(0, std::vector{1.0f, 1.0f, 110.0f, 10.0f, 0.0f});
+	morph.set_preset(1, std::vector{tweak::convert::db_to_linear(-12.0f), 4.0f, 440.0f, 1000.0f, 1.0f});
+	morph.set_preset(2, std::vector{0.0f, 0.0f, 20.0f, 0.0f, 0.0f});
+	auto out = std::vector<float>(kinds.size(), -1.0f);
+	morph.process(std::vector{0.0f, 0.0f, 0.0f}, out);
+	REQUIRE(out[0] == -1.0f);
+	morph.process(std::vector{1.0f, 1.0f, 0.0f}, out);
+	REQUIRE(tweak::convert::linear_to_db(out[0]) == doctest::Approx(-6.0f).epsilon(0.001));
+	REQUIRE(out[1] == doctest::Approx(2.0f).epsilon(0.001));
+	REQUIRE(out[2] == doctest::Approx(220.0f).epsilon(0.001));
+	REQUIRE(out[3] == doctest::Approx(100.0f).epsilon(0.001));
+	REQUIRE(out[4] == doctest::Approx(0.5f));
+	morph.process(std::vector{0.0f, 3.0f, -1.0f}, out);
+	REQUIRE(out[1] == doctest::Approx(4.0f).epsilon(0.001));
+}
+
+TEST_CASE("randomize and mutate") {
+	using tweak::param_kind;
+	namespace policies = tweak::std_::policies;
+	auto a = std::vector<float>(1000, 60.0f);
+	auto b = a;
+	auto locks = std::vector<std::uint8_t>(a.size());
+	locks[10] = 1;
+	auto rng = tweak::random::counter_rng{42};
+	tweak::random::randomize<policies::pitch<>>(&rng, locks, a);
+	REQUIRE(rng.counter() == a.size());
+	auto same = tweak::random::counter_rng{42};
+	tweak::random::randomize<policies::pitch<>>(&same, {}, b);
+	REQUIRE(a[10] == 60.0f);
+	REQUIRE(b[10] != 60.0f);
+	b[10] = 60.0f;
+	REQUIRE(a == b);
+	auto mean = 0.0f;
+	for (const auto v : a) {
+		REQUIRE(v >= 0.0f);
+		REQUIRE(v <= 127.0f);
+		REQUIRE(v == policies::pitch<>::stepify(v));
+		mean += v / float(a.size());
+	}
+	REQUIRE(mean == doctest::Approx(63.5f).epsilon(0.05));
+	auto freqs = std::vector<float>(1000, 1000.0f);
+	tweak::random::mutate<policies::frequency<>>(&rng, 0.01f, {}, freqs);
+	for (const auto v : freqs) {
+		REQUIRE(std::abs(tweak::convert::frequency_to_pitch(v) - tweak::convert::frequency_to_pitch(1000.0f)) <= 144.0f * 0.01f + 0.01f);
+	}
+	auto params = std::vector<tweak::any_param>{
+		{param_kind::frequency, 100.0f, 200.0f, 150.0f},
+		{param_kind::amp},
+		{param_kind::speed},
+	};
+	const auto index = tweak::kind_index{params};
+	const auto param_locks = std::vector<std::uint8_t>{0, 1};
+	tweak::random::randomize(&rng, params, index, param_locks);
+	REQUIRE(params[0].value() >= 100.0f);
+	REQUIRE(params[0].value() <= 200.0f);
+	REQUIRE(params[1].value() == 1.0f);
+	tweak::random::mutate(&rng, 0.0f, params, index, {});
+	REQUIRE(params[1].value() == doctest::Approx(1.0f));
+}
+
+TEST_CASE("macro mapping") {
+	using tweak::param_kind;
+	namespace policies = tweak::std_::policies;
+	auto params = std::vector<tweak::any_param>{
+		{param_kind::frequency},
+		{param_kind::amp},
+		{param_kind::pitch},
+		{param_kind::percentage},
+	};
+	auto mapping = tweak::macro::mapping{{
+		{0, param_kind::frequency, 100.0f, 10000.0f},
+		{1, param_kind::amp, 0.0f, 1.0f},
+		{3, param_kind::percentage, 1.0f, 0.0f, 2.0f},
+	}};
+	auto out = std::vector<float>(mapping.size());
+	mapping.process(0.0f, out);
+	REQUIRE(out[0] == doctest::Approx(100.0f));
+	REQUIRE(out[1] == 0.0f);
+	REQUIRE(out[2] == doctest::Approx(1.0f));
+	mapping.process(1.0f, out);
+	REQUIRE(out[0] == doctest::Approx(10000.0f));
+	REQUIRE(out[1] == doctest::Approx(1.0f));
+	REQUIRE(out[2] == doctest::Approx(0.0f));
+	for (const auto m : {0.1f, 0.37f, 0.5f, 0.83f}) {
+		mapping.process(m, out);
+		const auto freq = policies::frequency<>::from_normalized(tweak::math::lerp(policies::frequency<>::to_normalized(100.0f), policies::frequency<>::to_normalized(10000.0f), m));
+		REQUIRE(out[0] == doctest::Approx(freq).epsilon(0.0001));
+		REQUIRE(out[1] == doctest::Approx(policies::amp<>::from_normalized(m * policies::amp<>::to_normalized(1.0f))).epsilon(0.001));
+		REQUIRE(out[2] == doctest::Approx(1.0f - m * m).epsilon(0.001));
+	}
+	auto dirty = std::vector<std::uint8_t>(params.size());
+	REQUIRE(mapping.set(0.5f, params, dirty));
+	REQUIRE(params[0].value() == doctest::Approx(1000.0f).epsilon(0.001));
+	REQUIRE(dirty == std::vector<std::uint8_t>{1, 1, 0, 1});
+	dirty.assign(dirty.size(), 0);
+	REQUIRE_FALSE(mapping.set(0.5f, params, dirty));
+	REQUIRE(dirty == std::vector<std::uint8_t>{0, 0, 0, 0});
+	// NaN is treated as position 0
+	auto at_zero = std::vector<float>(mapping.size());
+	mapping.process(0.0f, at_zero);
+	mapping.process(std::numeric_limits<float>::quiet_NaN(), out);
+	REQUIRE(out == at_zero);
+	// Targets past the end of params or dirty are skipped
+	auto short_params = std::vector<tweak::any_param>{{param_kind::frequency}, {param_kind::amp}};
+	auto short_dirty  = std::vector<std::uint8_t>(1);
+	REQUIRE(mapping.set(1.0f, short_params, short_dirty));
+	REQUIRE(short_params[0].value() == doctest::Approx(10000.0f));
+	REQUIRE(short_dirty == std::vector<std::uint8_t>{1});
+	// Ratios reach INF, which takes the nearer row rather than giving NaN
+	const auto inf   = std::numeric_limits<float>::infinity();
+	const auto ratio = tweak::macro::mapping{{
+		{0, param_kind::ratio, 1.0f, inf},
+		{1, param_kind::ratio, inf, inf},
+	}};
+	auto ratios = std::vector<float>(2);
+	for (const auto m : {0.0f, 0.5f, 255.0f / 256.0f, 255.4f / 256.0f, 255.6f / 256.0f, 1.0f}) {
+		ratio.process(m, ratios);
+		REQUIRE(!std::isnan(ratios[0]));
+		REQUIRE(ratios[1] == inf);
+	}
+	ratio.process(0.0f, ratios);
+	REQUIRE(ratios[0] == 1.0f);
+	ratio.process(1.0f, ratios);
+	REQUIRE(ratios[0] == inf);
+	const auto lfo = std::vector<float>{0.0f, 0.25f, 0.5f, 0.75f, 1.0f};
+	auto block = std::vector<float>(lfo.size() * mapping.size());
+	mapping.process(lfo, block);
+	for (size_t f = 0; f < lfo.size(); f++) {
+		mapping.process(lfo[f], out);
+		for (size_t k = 0; k < mapping.size(); k++) {
+			REQUIRE(block[f * mapping.size() + k] == out[k]);
+		}
+	}
+}
+
+TEST_CASE("mod matrix") {
+	using tweak::param_kind;
+	namespace policies = tweak::std_::policies;
+	const auto kinds = std::vector<param_kind>{param_kind::amp, param_kind::speed, param_kind::frequency};
+	auto matrix = tweak::mod_matrix{kinds, 2, 2, 4};
+	matrix.set_base(0, 0, 0.5f);
+	matrix.set_base(1, 2, 200.0f);
+	matrix.connect(0, 0, 0.25f);
+	matrix.connect(1, 0, -0.1f);
+	const auto route = matrix.connect(1, 2, 0.0f);
+	matrix.connect(0, 1, 2.0f);
+	matrix.set_depth(*route, 0.3f);
+	REQUIRE(!matrix.connect(2, 0, 1.0f));
+	REQUIRE(!matrix.connect(0, 3, 1.0f));
+	REQUIRE(matrix.routes() == 4);
+	const auto frames = size_t(10);
+	auto sources = std::vector<float>(2 * frames);
+	for (size_t f = 0; f < frames; f++) {
+		sources[f]          = float(f) / float(frames - 1);
+		sources[frames + f] = f % 2 ? 1.0f : -1.0f;
+	}
+	auto out = std::vector<float>(kinds.size() * frames);
+	for (size_t voice = 0; voice < 2; voice++) {
+		matrix.process(voice, sources, frames, out);
+		for (size_t f = 0; f < frames; f++) {
+			const auto s0  = sources[f];
+			const auto s1  = sources[frames + f];
+			const auto amp = policies::amp<>::to_normalized(voice == 0 ? 0.5f : 1.0f) + 0.25f * s0 - 0.1f * s1;
+			REQUIRE(out[f] == doctest::Approx(policies::amp<>::from_normalized(std::clamp(amp, 0.0f, 1.0f))).epsilon(0.001));
+			const auto speed = policies::speed<>::to_normalized(policies::speed<>::DEFAULT) + 2.0f * s0;
+			REQUIRE(out[frames + f] == doctest::Approx(policies::speed<>::from_normalized(std::clamp(speed, 0.0f, 1.0f))).epsilon(0.001));
+			const auto freq = policies::frequency<>::to_normalized(voice == 0 ? 1000.0f : 200.0f) + 0.3f * s1;
+			REQUIRE(out[2 * frames + f] == doctest::Approx(policies::frequency<>::from_normalized(std::clamp(freq, 0.0f, 1.0f))).epsilon(0.001));
+		}
+	}
+	REQUIRE(out[2 * frames - 1] == policies::speed<>::MAX);
+	// A short output keeps the caller's stride and processes fewer frames
+	auto full      = out;
+	auto short_out = std::vector<float>(kinds.size() * frames - 5, -1.0f);
+	matrix.process(1, sources, frames, short_out);
+	for (size_t d = 0; d < kinds.size(); d++) {
+		for (size_t f = 0; f < 5; f++) {
+			REQUIRE(short_out[d * frames + f] == full[d * frames + f]);
+		}
+	}
+	REQUIRE(short_out[5] == -1.0f);
+	// Voices and destinations out of range are ignored
+	matrix.set_base(2, 0, 1.0f);
+	matrix.set_base(0, 3, 1.0f);
+	auto untouched = std::vector<float>(out.size(), -1.0f);
+	matrix.process(2, sources, frames, untouched);
+	REQUIRE(std::all_of(untouched.begin(), untouched.end(), [](float v) { return v == -1.0f; }));
+	matrix.clear();
+	matrix.process(0, sources, frames, out);
+	REQUIRE(out[0] == doctest::Approx(0.5f).epsilon(0.001));
+	REQUIRE(out[frames] == doctest::Approx(policies::speed<>::DEFAULT).epsilon(0.001));
+	// Ratios go up to INF at the top of the table
+	const auto ratio_kind = std::vector<param_kind>{param_kind::ratio};
+	auto ratio = tweak::mod_matrix{ratio_kind, 1, 1};
+	ratio.set_base(0, 0, policies::ratio<>::MIN);
+	ratio.connect(0, 0, 1.0f);
+	const auto positions = std::vector<float>{0.5f, 1023.0f / 1024.0f, 1023.7f / 1024.0f, 1.0f};
+	auto ratios = std::vector<float>(positions.size());
+	ratio.process(0, positions, positions.size(), ratios);
+	REQUIRE(std::isfinite(ratios[0]));
+	REQUIRE(std::isfinite(ratios[1]));
+	REQUIRE(ratios[2] == std::numeric_limits<float>::infinity());
+	REQUIRE(ratios[3] == std::numeric_limits<float>::infinity());
+}
+
+TEST_CASE("per voice arrays") {
+	namespace voice = tweak::voice;
+	namespace policies = tweak::std_::policies;
+	auto in  = voice::array{20};
+	auto out = voice::array{20, -1.0f};
+	REQUIRE(in.size() == 20);
+	REQUIRE(in.padded_size() == 32);
+	REQUIRE(reinterpret_cast<std::uintptr_t>(in.data()) % 64 == 0);
+	auto active = voice::mask{20};
+	REQUIRE_FALSE(active.any(0));
+	active.set(3, true);
+	active.set(19, true);
+	REQUIRE(active.any(0));
+	REQUIRE(active.any(16));
+	REQUIRE(active.count() == 2);
+	for (size_t v = 0; v < in.size(); v++) {
+		in[v] = -60.0f + 4.0f * float(v);
+	}
+	voice::db_to_linear(active, in, &out);
+	REQUIRE(out[3] == doctest::Approx(tweak::convert::db_to_linear(in[3])).epsilon(1e-6));
+	REQUIRE(out[19] == doctest::Approx(tweak::convert::db_to_linear(in[19])).epsilon(1e-6));
+	REQUIRE(out[4] == -1.0f);
+	voice::p_to_ff(active, in, &out);
+	REQUIRE(out[3] == doctest::Approx(std::exp2(in[3] / 12.0f)).epsilon(1e-6));
+	voice::linear_to_speed(active, in, &out);
+	REQUIRE(out[19] == doctest::Approx(std::exp2(in[19])).epsilon(1e-6));
+	for (const auto x : {-130.0f, -20.5f, -0.25f, 0.0f, 0.5f, 3.75f, 100.0f}) {
+		REQUIRE(tweak::fastmath::exp2(x) == doctest::Approx(std::exp2(x)).epsilon(1e-6));
+	}
+	REQUIRE(tweak::fastmath::exp2(1000.0f) == std::numeric_limits<float>::infinity());
+	voice::constrain<policies::pitch<>>(active, &in);
+	REQUIRE(in[3] == 0.0f);
+	REQUIRE(in[2] == -52.0f);
+	voice::clamp(active, 0.0f, 10.0f, &in);
+	REQUIRE(in[19] == 10.0f);
+	auto targets  = voice::array{20, 1.0f};
+	auto smoother = voice::smoother{20, 0.5f};
+	smoother.reset(19, 0.5f);
+	auto rows = std::vector<float>(4 * in.padded_size(), -1.0f);
+	smoother.process(active, targets, 4, rows);
+	REQUIRE(rows[3] == 0.5f);
+	REQUIRE(rows[in.padded_size() + 3] == 0.75f);
+	REQUIRE(rows[3 * in.padded_size() + 19] == doctest::Approx(1.0f - 0.5f / 16.0f));
+	REQUIRE(rows[2] == -1.0f);
+	REQUIRE(smoother.state()[3] == doctest::Approx(1.0f - 1.0f / 16.0f));
+	REQUIRE(smoother.state()[2] == 0.0f);
+}
+
+TEST_CASE("varispeed") {
+	namespace varispeed = tweak::varispeed;
+	const auto base = 44100.0 / 48000.0;
+	auto gen = varispeed::generator{base, 4};
+	const auto speed = std::vector<float>{1, 1, 0, 0, 0, 0, 0, 2, 2, 2, 2, 2};
+	auto out = std::vector<double>(speed.size());
+	gen.process(speed, {}, out);
+	const auto expected = std::vector<double>{1, 1, 0.75, 0.5, 0.25, 0, 0, 0.5, 1, 1.5, 2, 2};
+	for (size_t f = 0; f < out.size(); f++) {
+		REQUIRE(out[f] == doctest::Approx(expected[f] * base));
+	}
+	gen.reset(tweak::std_::speed::FREEZE);
+	REQUIRE(gen.frozen());
+	gen.reset(1.0f);
+	const auto pitch = std::vector<float>(speed.size(), 12.0f);
+	gen.process(std::vector<float>(speed.size(), 0.5f), pitch, out);
+	REQUIRE(out.back() == base);
+	const auto fifth = std::vector<float>(speed.size(), 7.0f);
+	gen.process(std::vector<float>(speed.size(), 1.0f), fifth, out);
+	REQUIRE(out.back() == doctest::Approx(base * std::exp2(7.0 / 12.0)).epsilon(1e-6));
+	// A short pitch buffer holds its last value
+	gen.process(std::vector<float>(speed.size(), 1.0f), std::span{fifth}.first(3), out);
+	REQUIRE(out.back() == out[2]);
+	auto long_out = std::vector<double>(600);
+	gen.process(std::vector<float>(600, 1.0f), std::vector<float>(300, 7.0f), long_out);
+	REQUIRE(std::all_of(long_out.begin(), long_out.end(), [&long_out](double v) { return v == long_out[0]; }));
+	// An hour at 48kHz
+	gen.reset(1.0f);
+	const auto block = size_t(4096);
+	const auto total = size_t(3600 * 48000);
+	const auto ones  = std::vector<float>(block, 1.0f);
+	auto increments  = std::vector<std::uint64_t>(block);
+	auto position    = varispeed::accumulator{};
+	for (size_t done = 0; done < total; done += block) {
+		const auto n = std::min(block, total - done);
+		gen.process(std::span{ones}.first(n), {}, std::span{increments}.first(n));
+		position.advance(std::span{increments}.first(n));
+	}
+	REQUIRE(std::abs(position.position() - 3600.0 * 44100.0) < 0.05);
+	position.set(10.25);
+	REQUIRE(position.index() == 10);
+	REQUIRE(position.fraction() == 0.25f);
+	position.advance(varispeed::to_fixed(0.75));
+	REQUIRE(position.position() == 11.0);
+}
+
+TEST_CASE("fastmath tiers") {
+	namespace fastmath = tweak::fastmath;
+	namespace convert = tweak::convert;
+	// The bounds in the header: the tier's error, plus the rounding of the
+	// result for log2 and of the product with LOG2E or LN2 for exp and log
+	const auto check = [](auto tier, double tolerance) {
+		for (auto x = -20.0f; x < 20.0f; x += 0.013f) {
+			REQUIRE(std::abs(fastmath::exp2(x, tier) / std::exp2(double(x)) - 1.0) < tolerance);
+			REQUIRE(std::abs(fastmath::exp(x, tier) / std::exp(double(x)) - 1.0) < tolerance + std::abs(x) * 7e-8);
+		}
+		for (auto x = 0.5f; x < 2.0f; x += 0.0007f) {
+			REQUIRE(std::abs(fastmath::log2(x, tier) - std::log2(double(x))) < tolerance);
+		}
+		for (auto x = 1e-6f; x < 1e6f; x *= 1.037f) {
+			const auto log2 = std::log2(double(x));
+			REQUIRE(std::abs(fastmath::log2(x, tier) - log2) < tolerance + std::abs(log2) * 7e-8);
+			REQUIRE(std::abs(fastmath::log(x, tier) - std::log(double(x))) < tolerance + std::abs(log2) * 7e-8);
+		}
+		for (auto i = -30; i <= 30; i++) {
+			REQUIRE(fastmath::exp2(float(i), tier) == std::ldexp(1.0f, i));
+			REQUIRE(fastmath::log2(std::ldexp(1.0f, i), tier) == float(i));
+		}
+	};
+	check(fastmath::coarse, 1.1e-4);
+	check(fastmath::medium, 6e-6);
+	check(fastmath::full, 1.2e-7);
+	REQUIRE(fastmath::exp2(-200.0f) == 0.0f);
+	// Rounds to 128 but is still a float
+	REQUIRE(fastmath::exp2(127.7f) == doctest::Approx(std::exp2(double(127.7f))).epsilon(1.2e-7));
+	REQUIRE(fastmath::exp2(127.5f, fastmath::coarse) == doctest::Approx(std::exp2(127.5)).epsilon(1.1e-4));
+	REQUIRE(fastmath::exp2(128.0f) == std::numeric_limits<float>::infinity());
+	auto in  = std::vector<float>{0.5f, 1.0f, 2.0f, 100.0f};
+	auto out = std::vector<float>(in.size());
+	fastmath::log2(in, out, fastmath::medium);
+	REQUIRE(out[2] == 1.0f);
+	fastmath::exp2(out, out);
+	REQUIRE(out[3] == doctest::Approx(100.0f).epsilon(1e-5));
+	// Fractional octaves used to be truncated
+	REQUIRE(convert::linear_to_speed(-0.5f) == doctest::Approx(std::sqrt(0.5f)));
+	REQUIRE(convert::linear_to_speed(1.1f) == doctest::Approx(std::exp2(1.1f)));
+	REQUIRE(convert::linear_to_speed(3.0f) == 8.0f);
+	REQUIRE(convert::speed_to_linear(convert::linear_to_speed(-2.25f)) == doctest::Approx(-2.25f));
+	for (const auto v : {0.1f, 0.5f, 0.9f}) {
+		REQUIRE(convert::linear_to_speed(v, fastmath::coarse) == doctest::Approx(convert::linear_to_speed(v)).epsilon(2e-4));
+		REQUIRE(convert::linear_to_filter_hz(v, fastmath::full) == doctest::Approx(convert::linear_to_filter_hz(v)).epsilon(1e-5));
+		REQUIRE(convert::linear_to_ratio(v, fastmath::medium) == doctest::Approx(convert::linear_to_ratio(v)).epsilon(1e-4));
+		REQUIRE(convert::ratio_to_linear(convert::linear_to_ratio(v), fastmath::full) == doctest::Approx(v).epsilon(1e-4));
+	}
+	REQUIRE(convert::p_to_ff(12.0f, fastmath::coarse) == 2.0f);
+	REQUIRE(convert::ff_to_p(0.5f, fastmath::coarse) == -12.0f);
+	REQUIRE(convert::pitch_to_frequency(69.0f, fastmath::medium) == doctest::Approx(440.0f).epsilon(1e-5));
+	REQUIRE(convert::frequency_to_pitch(440.0f, fastmath::full) == doctest::Approx(69.0f).epsilon(1e-5));
+	REQUIRE(convert::db_to_linear(-6.0f, fastmath::full) == doctest::Approx(convert::db_to_linear(-6.0f)).epsilon(1e-5));
+	REQUIRE(convert::linear_to_db(0.5f, fastmath::full) == doctest::Approx(convert::linear_to_db(0.5f)).epsilon(1e-5));
+	// Silence, subnormals and infinities
+	const auto inf = std::numeric_limits<float>::infinity();
+	REQUIRE(convert::linear_to_db(0.0f, fastmath::full) == -inf);
+	REQUIRE(convert::linear_to_db(-1.0f, fastmath::coarse) == -inf);
+	REQUIRE(convert::linear_to_db(1e-40f, fastmath::full) == doctest::Approx(convert::linear_to_db(1e-40f)).epsilon(1e-5));
+	REQUIRE(fastmath::exp2(-inf) == 0.0f);
+	REQUIRE(fastmath::exp2(inf, fastmath::coarse) == inf);
+	REQUIRE(fastmath::exp2(-128.0f) == 0.0f);
+	REQUIRE(std::isnan(fastmath::exp2(std::numeric_limits<float>::quiet_NaN())));
+	auto silent = tweak::voice::array{4, -inf};
+	auto gains  = tweak::voice::array{4, -1.0f};
+	auto all    = tweak::voice::mask{4};
+	for (size_t v = 0; v < 4; v++) { all.set(v, true); }
+	tweak::voice::db_to_linear(all, silent, &gains);
+	REQUIRE(gains[0] == 0.0f);
+	REQUIRE(gains[3] == 0.0f);
+}
+
+TEST_CASE("fixed point") {
+	namespace fixed = tweak::fixed;
+	using fixed::q15;
+	using fixed::q31;
+	REQUIRE(fixed::to_fixed<q15>(0.5f) == 16384);
+	REQUIRE(fixed::to_fixed<q15>(1.0f) == 32767);
+	REQUIRE(fixed::to_fixed<q31>(-1.0f) == std::numeric_limits<q31>::min());
+	REQUIRE(fixed::to_float(q15(-16384)) == -0.5f);
+	REQUIRE(fixed::lerp(q15(-8192), q15(24576), q15(16384)) == 8192);
+	REQUIRE(fixed::lerp(q31(0), q31(1 << 30), q31(1 << 30)) == 1 << 29);
+	REQUIRE(fixed::inverse_lerp(q15(-8192), q15(24576), q15(8192)) == 16384);
+	REQUIRE(fixed::inverse_lerp(q15(0), q15(100), q15(200)) == 32767);
+	REQUIRE(fixed::inverse_lerp(q15(0), q15(100), q15(-5)) == -1638);
+	REQUIRE(fixed::inverse_lerp(q15(0), q15(100), q15(-200)) == -32768);
+	REQUIRE(fixed::inverse_lerp(q15(7), q15(7), q15(7)) == 0);
+	REQUIRE(fixed::stepify(q15(149), q15(100)) == 100);
+	REQUIRE(fixed::stepify(q15(150), q15(100)) == 200);
+	REQUIRE(fixed::stepify(q15(-150), q15(100)) == -100);
+	REQUIRE(fixed::stepify(q15(32767), q15(1000)) == 32767);
+	REQUIRE(fixed::constrain(q31(-5), q31(0), q31(10)) == 0);
+	// Exact where the answer is a power of two
+	REQUIRE(fixed::db_to_linear(q15(0)) == 32768 / fixed::GAIN_SCALE);
+	REQUIRE(fixed::db_to_linear(q31(0)) == 1 << 27);
+	REQUIRE(fixed::p_to_ff(fixed::to_fixed<q15>(12.0f / fixed::PITCH_SCALE)) == 2 * 32768 / fixed::GAIN_SCALE);
+	REQUIRE(fixed::ff_to_p(q31(1 << 26)) == fixed::to_fixed<q31>(-12.0f / fixed::PITCH_SCALE));
+	REQUIRE(fixed::linear_to_db(q15(0)) == std::numeric_limits<q15>::min());
+	REQUIRE(fixed::db_to_linear(q15(32767)) == 32767);
+	static_assert(fixed::linear_to_db(fixed::db_to_linear(q31(0))) == 0);
+	static_assert(fixed::pitch_to_frequency(q15(69 * 32768 / fixed::PITCH_SCALE)) == 440);
+	// The bounds in the header, checked for every Q15 input and a sweep of
+	// Q31 ones. Each call returns the worst error over its bound, in
+	// steps, so passes are at most 1: half a step plus rel of the exact
+	// result plus abs in the result's units.
+	const auto worst = []<class Q>(Q (*fn)(Q), auto exact, double in_scale, double out_scale, double rel, double abs, std::int64_t stride) {
+		const auto one = double(std::int64_t(1) << fixed::FRACTION_BITS<Q>);
+		const auto lo  = double(std::numeric_limits<Q>::min());
+		const auto hi  = double(std::numeric_limits<Q>::max());
+		auto out = 0.0;
+		for (auto q = std::int64_t(lo); q <= std::int64_t(hi); q += stride) {
+			const auto x = double(q) / one * in_scale;
+			if (std::isnan(exact(x))) { continue; }
+			const auto e     = std::clamp(exact(x) / out_scale * one, lo, hi);
+			const auto bound = 0.5 + rel * std::abs(e) + abs / out_scale * one;
+			out = std::max(out, std::abs(double(fn(Q(q))) - e) / bound);
+		}
+		return out;
+	};
+	const auto db_to_gain  = [](double db) { return std::pow(10.0, db / 20.0); };
+	const auto gain_to_db  = [](double g) { return g > 0.0 ? 20.0 * std::log10(g) : std::nan(""); };
+	const auto note_to_hz  = [](double note) { return 440.0 * std::exp2((note - 69.0) / 12.0); };
+	const auto hz_to_note  = [](double hz) { return hz > 0.0 ? 69.0 + 12.0 * std::log2(hz / 440.0) : std::nan(""); };
+	const auto semis_to_ff = [](double p) { return std::exp2(p / 12.0); };
+	const auto ff_to_semis = [](double ff) { return ff > 0.0 ? 12.0 * std::log2(ff) : std::nan(""); };
+	for (const auto stride : {std::int64_t(1), std::int64_t(9973)}) {
+		const auto check = [&]<class Q>(Q) {
+			REQUIRE(worst(fixed::db_to_linear<Q>, db_to_gain, fixed::DB_SCALE, fixed::GAIN_SCALE, 2.5e-7, 0.0, stride) <= 1.0);
+			REQUIRE(worst(fixed::linear_to_db<Q>, gain_to_db, fixed::GAIN_SCALE, fixed::DB_SCALE, 0.0, 3e-6, stride) <= 1.0);
+			REQUIRE(worst(fixed::pitch_to_frequency<Q>, note_to_hz, fixed::PITCH_SCALE, fixed::HZ_SCALE, 2.5e-7, 0.0, stride) <= 1.0);
+			REQUIRE(worst(fixed::frequency_to_pitch<Q>, hz_to_note, fixed::HZ_SCALE, fixed::PITCH_SCALE, 0.0, 8e-6, stride) <= 1.0);
+			REQUIRE(worst(fixed::p_to_ff<Q>, semis_to_ff, fixed::PITCH_SCALE, fixed::GAIN_SCALE, 2.5e-7, 0.0, stride) <= 1.0);
+			REQUIRE(worst(fixed::ff_to_p<Q>, ff_to_semis, fixed::GAIN_SCALE, fixed::PITCH_SCALE, 0.0, 8e-6, stride) <= 1.0);
+		};
+		if (stride == 1) { check(q15{}); }
+		else             { check(q31{}); }
+	}
+	// Which in Q15 is less than 0.003 of a step more than half
+	const auto extra = 0.003 / 32768.0;
+	REQUIRE(worst(fixed::db_to_linear<q15>, db_to_gain, fixed::DB_SCALE, fixed::GAIN_SCALE, 0.0, extra * fixed::GAIN_SCALE, 1) <= 1.0);
+	REQUIRE(worst(fixed::linear_to_db<q15>, gain_to_db, fixed::GAIN_SCALE, fixed::DB_SCALE, 0.0, extra * fixed::DB_SCALE, 1) <= 1.0);
+	REQUIRE(worst(fixed::pitch_to_frequency<q15>, note_to_hz, fixed::PITCH_SCALE, fixed::HZ_SCALE, 0.0, extra * fixed::HZ_SCALE, 1) <= 1.0);
+	REQUIRE(worst(fixed::frequency_to_pitch<q15>, hz_to_note, fixed::HZ_SCALE, fixed::PITCH_SCALE, 0.0, extra * fixed::PITCH_SCALE, 1) <= 1.0);
+	REQUIRE(worst(fixed::p_to_ff<q15>, semis_to_ff, fixed::PITCH_SCALE, fixed::GAIN_SCALE, 0.0, extra * fixed::GAIN_SCALE, 1) <= 1.0);
+	REQUIRE(worst(fixed::ff_to_p<q15>, ff_to_semis, fixed::GAIN_SCALE, fixed::PITCH_SCALE, 0.0, extra * fixed::PITCH_SCALE, 1) <= 1.0);
+	// Bit exact: pinned hash of a sweep over every conversion
+	auto hash = std::uint64_t(14695981039346656037ull);
+	for (auto q = std::int64_t(-2147483648); q < 2147483648; q += 65537) {
+		const auto v = q31(q);
+		for (const auto r : {fixed::db_to_linear(v), fixed::linear_to_db(v), fixed::pitch_to_frequency(v), fixed::frequency_to_pitch(v), fixed::p_to_ff(v), fixed::ff_to_p(v)}) {
+			hash = (hash ^ std::uint32_t(r)) * 1099511628211ull;
+		}
+	}
+	REQUIRE(hash == 16948479479778816416ull);
+}